@@ -0,0 +1,54 @@
+#ifndef ARRAYVIEW_H
+#define ARRAYVIEW_H
+
+#include "DynamicArray.h"
+#include <vector>
+#include <stdexcept>
+
+// Non-owning read-only view of contiguous elements (a C++17 stand-in for std::span<const T>).
+// It does not keep the viewed array alive and is invalidated when that array reallocates.
+template<typename T>
+class ArrayView
+{
+private:
+    const T *data = nullptr;
+    size_t size = 0;
+
+public:
+    ArrayView() = default;
+
+    ArrayView(const T *data, size_t size) : data(data), size(size) {}
+
+    ArrayView(const DynamicArray<T> &array) : data(array.get_data()), size(array.get_size()) {}
+
+    ArrayView(const std::vector<T> &array) : data(array.data()), size(array.size()) {}
+
+    const T *begin() const noexcept
+    {
+        return data;
+    }
+
+    const T *end() const noexcept
+    {
+        return data + size;
+    }
+
+    size_t get_size() const noexcept
+    {
+        return size;
+    }
+
+    bool is_empty() const noexcept
+    {
+        return size == 0;
+    }
+
+    const T &operator[](const size_t index) const
+    {
+        if (index >= size)
+            throw std::out_of_range("Index out of range!");
+        return data[index];
+    }
+};
+
+#endif // ARRAYVIEW_H
@@ -0,0 +1,569 @@
+#ifndef CONTRACTIONHIERARCHY_H
+#define CONTRACTIONHIERARCHY_H
+
+#include "DynamicArray.h"
+#include "GraphParts.h"
+#include "VertexIndex.h"
+#include "GraphAlgorithms.h"
+#include "Path.h"
+#include <vector>
+#include <queue>
+#include <chrono>
+#include <random>
+
+struct ContractionStats
+{
+    double preprocessingMilliseconds = 0;
+    size_t originalArcs = 0;
+    size_t shortcuts = 0;
+    size_t memoryBytes = 0; // hierarchy arrays, without the vertex index
+};
+
+// Contraction hierarchy over a static snapshot with non-negative weights. Vertices are contracted one by
+// one, cheapest first (edge difference plus contracted neighbours, re-evaluated lazily); contracting v
+// adds a shortcut u -> w for every u -> v -> w that a witness search around v cannot match. Every arc
+// ends up stored once: with its lower-ranked endpoint, in the up arrays when it leads to a higher rank,
+// otherwise in the down arrays (indexed by target). A query is a bidirectional Dijkstra that only climbs
+// ranks; the shortcuts on the result are unpacked through their middle vertices.
+template<typename T>
+class ContractionHierarchy
+{
+private:
+    // Witness searches give up after this many settled vertices and then keep the shortcut; the cheaper
+    // limit is used while only estimating priorities.
+    static constexpr int WitnessSettleLimit = 500;
+    static constexpr int EstimateSettleLimit = 25;
+
+    struct Arc
+    {
+        int neighbor;
+        int weight;
+        int middle; // -1 for an arc of the original graph
+    };
+
+    VertexIndex<T> index;
+    DynamicArray<int> rank;
+    DynamicArray<uint32_t> upOffsets;
+    DynamicArray<uint32_t> upTargets;
+    DynamicArray<int> upWeights;
+    DynamicArray<int> upMiddles;
+    DynamicArray<uint32_t> downOffsets;
+    DynamicArray<uint32_t> downSources;
+    DynamicArray<int> downWeights;
+    DynamicArray<int> downMiddles;
+    ContractionStats stats;
+
+    static Arc *FindArc(std::vector<Arc> &arcs, int neighbor)
+    {
+        for (auto &arc : arcs) {
+            if (arc.neighbor == neighbor) {
+                return &arc;
+            }
+        }
+        return nullptr;
+    }
+
+    // Keeps only the cheapest u -> w arc in the remaining graph.
+    static void AddOrLower(std::vector<std::vector<Arc>> &out, std::vector<std::vector<Arc>> &in, int u, int w, int weight, int middle)
+    {
+        Arc *forward = FindArc(out[u], w);
+        if (forward == nullptr) {
+            out[u].push_back(Arc{w, weight, middle});
+            in[w].push_back(Arc{u, weight, middle});
+        } else if (weight < forward->weight) {
+            *forward = Arc{w, weight, middle};
+            *FindArc(in[w], u) = Arc{u, weight, middle};
+        }
+    }
+
+    static void RemoveArc(std::vector<Arc> &arcs, int neighbor)
+    {
+        for (size_t i = 0; i < arcs.size(); i++) {
+            if (arcs[i].neighbor == neighbor) {
+                arcs[i] = arcs.back();
+                arcs.pop_back();
+                return;
+            }
+        }
+    }
+
+    // Shortcuts needed to contract v, as (u, w, weight) in shortcuts; only counted when shortcuts is null.
+    static int FindShortcuts(const std::vector<std::vector<Arc>> &out, const std::vector<std::vector<Arc>> &in, int v,
+                             DijkstraWorkspace &workspace, std::vector<Arc> *shortcuts, std::vector<int> *sources)
+    {
+        int settleLimit = shortcuts == nullptr ? EstimateSettleLimit : WitnessSettleLimit;
+        int count = 0;
+        for (const Arc &incoming : in[v]) {
+            int u = incoming.neighbor;
+            int limit = 0;
+            for (const Arc &outgoing : out[v]) {
+                if (outgoing.neighbor != u) {
+                    limit = std::max(limit, incoming.weight + outgoing.weight);
+                }
+            }
+
+            // Dijkstra from u that avoids v, up to the longest path through v or until every out-neighbour of
+            // v is settled.
+            workspace.Reset(static_cast<int>(out.size()));
+            workspace.Label(u, 0, -1);
+            PushHeap(workspace.heap, HeapEntry{0, 0, u});
+            int settled = 0;
+            size_t targetsLeft = out[v].size();
+            while (!workspace.heap.empty() && settled < settleLimit && targetsLeft > 0) {
+                HeapEntry top = PopHeap(workspace.heap);
+                if (top.key != workspace.GetDistance(top.slot)) {
+                    continue;
+                }
+                if (top.key > limit) {
+                    break;
+                }
+                ++settled;
+                int slot = top.slot;
+                if (std::any_of(out[v].begin(), out[v].end(), [slot](const Arc &arc) { return arc.neighbor == slot; })) {
+                    --targetsLeft;
+                }
+                for (const Arc &arc : out[top.slot]) {
+                    int newDist = top.key + arc.weight;
+                    if (arc.neighbor != v && workspace.GetDistance(arc.neighbor) > newDist) {
+                        workspace.Label(arc.neighbor, newDist, top.slot);
+                        PushHeap(workspace.heap, HeapEntry{newDist, newDist, arc.neighbor});
+                    }
+                }
+            }
+
+            for (const Arc &outgoing : out[v]) {
+                int w = outgoing.neighbor;
+                int via = incoming.weight + outgoing.weight;
+                if (w == u || workspace.GetDistance(w) <= via) {
+                    continue;
+                }
+                ++count;
+                if (shortcuts != nullptr) {
+                    shortcuts->push_back(Arc{w, via, v});
+                    sources->push_back(u);
+                }
+            }
+        }
+        return count;
+    }
+
+    static int Priority(const std::vector<std::vector<Arc>> &out, const std::vector<std::vector<Arc>> &in, int v,
+                        const std::vector<int> &contractedNeighbours, DijkstraWorkspace &workspace)
+    {
+        int removed = static_cast<int>(in[v].size() + out[v].size());
+        return 2 * FindShortcuts(out, in, v, workspace, nullptr, nullptr) - removed + contractedNeighbours[v];
+    }
+
+    static void BuildCsr(const std::vector<std::vector<Arc>> &arcs, DynamicArray<uint32_t> &offsets, DynamicArray<uint32_t> &neighbors,
+                         DynamicArray<int> &weights, DynamicArray<int> &middles)
+    {
+        offsets = DynamicArray<uint32_t>(arcs.size() + 1);
+        offsets[0] = 0;
+        for (size_t v = 0; v < arcs.size(); v++) {
+            offsets[v + 1] = offsets[v] + static_cast<uint32_t>(arcs[v].size());
+        }
+        neighbors = DynamicArray<uint32_t>(offsets[arcs.size()]);
+        weights = DynamicArray<int>(offsets[arcs.size()]);
+        middles = DynamicArray<int>(offsets[arcs.size()]);
+        for (size_t v = 0; v < arcs.size(); v++) {
+            uint32_t pos = offsets[v];
+            for (const Arc &arc : arcs[v]) {
+                neighbors[pos] = static_cast<uint32_t>(arc.neighbor);
+                weights[pos] = arc.weight;
+                middles[pos] = arc.middle;
+                ++pos;
+            }
+        }
+    }
+
+    EdgeRange UpArcs(int slot) const
+    {
+        uint32_t begin = upOffsets[slot];
+        return EdgeRange(upTargets.get_data() + begin, upWeights.get_data() + begin, upOffsets[slot + 1] - begin);
+    }
+
+    EdgeRange DownArcs(int slot) const
+    {
+        uint32_t begin = downOffsets[slot];
+        return EdgeRange(downSources.get_data() + begin, downWeights.get_data() + begin, downOffsets[slot + 1] - begin);
+    }
+
+    // Middle vertex of the stored arc from -> to, -1 when it is an original arc.
+    int MiddleOf(int from, int to) const
+    {
+        if (rank[from] < rank[to]) {
+            for (uint32_t i = upOffsets[from]; i < upOffsets[from + 1]; i++) {
+                if (static_cast<int>(upTargets[i]) == to) {
+                    return upMiddles[i];
+                }
+            }
+        } else {
+            for (uint32_t i = downOffsets[to]; i < downOffsets[to + 1]; i++) {
+                if (static_cast<int>(downSources[i]) == from) {
+                    return downMiddles[i];
+                }
+            }
+        }
+        return -1;
+    }
+
+public:
+    ContractionHierarchy() = default;
+
+    template<typename G>
+    explicit ContractionHierarchy(const G &graph)
+    {
+        auto startTime = std::chrono::steady_clock::now();
+        if (graph.GetMinWeight() < 0) {
+            std::cout << "Contraction hierarchy requires non-negative weights." << std::endl;
+            return;
+        }
+        index = graph.GetIndex();
+        int numVertices = graph.GetSize();
+
+        std::vector<std::vector<Arc>> out(numVertices), in(numVertices);
+        for (int u = 0; u < numVertices; u++) {
+            for (const auto &edge : graph.OutEdges(static_cast<uint32_t>(u))) {
+                ++stats.originalArcs;
+                if (static_cast<int>(edge.GetTarget()) != u) {
+                    AddOrLower(out, in, u, static_cast<int>(edge.GetTarget()), edge.GetWeight(), -1);
+                }
+            }
+        }
+
+        DijkstraWorkspace workspace;
+        std::vector<int> contractedNeighbours(numVertices, 0);
+        // Entries whose priority no longer matches priority[v] are stale and skipped.
+        std::vector<int> priority(numVertices);
+        std::vector<bool> contracted(numVertices, false);
+        std::priority_queue<std::pair<int, int>, std::vector<std::pair<int, int>>, std::greater<std::pair<int, int>>> queue;
+        for (int v = 0; v < numVertices; v++) {
+            priority[v] = Priority(out, in, v, contractedNeighbours, workspace);
+            queue.push(std::make_pair(priority[v], v));
+        }
+        auto update = [&](int x) {
+            priority[x] = Priority(out, in, x, contractedNeighbours, workspace);
+            queue.push(std::make_pair(priority[x], x));
+        };
+
+        rank = DynamicArray<int>(static_cast<size_t>(numVertices));
+        std::vector<std::vector<Arc>> up(numVertices), down(numVertices);
+        std::vector<Arc> shortcuts;
+        std::vector<int> sources;
+        int nextRank = 0;
+        while (!queue.empty()) {
+            std::pair<int, int> top = queue.top();
+            int v = top.second;
+            queue.pop();
+            if (contracted[v] || top.first != priority[v]) {
+                continue;
+            }
+            // Lazy update: contract v only if it is still the cheapest after recomputing its priority.
+            priority[v] = Priority(out, in, v, contractedNeighbours, workspace);
+            if (!queue.empty() && priority[v] > queue.top().first) {
+                queue.push(std::make_pair(priority[v], v));
+                continue;
+            }
+
+            shortcuts.clear();
+            sources.clear();
+            FindShortcuts(out, in, v, workspace, &shortcuts, &sources);
+            rank[v] = nextRank++;
+            contracted[v] = true;
+            // Every neighbour left is contracted later, so the arcs of v are final.
+            up[v] = std::move(out[v]);
+            down[v] = std::move(in[v]);
+            out[v].clear();
+            in[v].clear();
+            for (const Arc &arc : up[v]) {
+                RemoveArc(in[arc.neighbor], v);
+                ++contractedNeighbours[arc.neighbor];
+            }
+            for (const Arc &arc : down[v]) {
+                RemoveArc(out[arc.neighbor], v);
+                ++contractedNeighbours[arc.neighbor];
+            }
+            for (size_t i = 0; i < shortcuts.size(); i++) {
+                AddOrLower(out, in, sources[i], shortcuts[i].neighbor, shortcuts[i].weight, v);
+            }
+            for (const Arc &arc : up[v]) {
+                update(arc.neighbor);
+            }
+            for (const Arc &arc : down[v]) {
+                update(arc.neighbor);
+            }
+        }
+
+        BuildCsr(up, upOffsets, upTargets, upWeights, upMiddles);
+        BuildCsr(down, downOffsets, downSources, downWeights, downMiddles);
+        size_t storedArcs = upTargets.get_size() + downSources.get_size();
+        for (int v = 0; v < numVertices; v++) {
+            for (const Arc &arc : up[v]) {
+                stats.shortcuts += arc.middle != -1;
+            }
+            for (const Arc &arc : down[v]) {
+                stats.shortcuts += arc.middle != -1;
+            }
+        }
+        stats.memoryBytes = sizeof(int) * static_cast<size_t>(numVertices) + 2 * sizeof(uint32_t) * (static_cast<size_t>(numVertices) + 1)
+                            + storedArcs * (sizeof(uint32_t) + 2 * sizeof(int));
+        stats.preprocessingMilliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - startTime).count();
+    }
+
+    int GetSize() const
+    {
+        return index.GetSize();
+    }
+
+    int FindSlot(T vertexName) const
+    {
+        return index.Find(vertexName);
+    }
+
+    const ContractionStats& GetStats() const
+    {
+        return stats;
+    }
+
+    // Labels forward and backward and returns the vertex where the best path meets, -1 when there is none.
+    // Each side stops once its queue key reaches the best path found so far. A vertex that its own side
+    // reaches more cheaply through a higher-ranked neighbour is not on a shortest upward path, so its arcs
+    // are not relaxed (stall-on-demand).
+    int QueryIds(int startVertexIndex, int endVertexIndex, DijkstraWorkspace &forward, DijkstraWorkspace &backward) const
+    {
+        forward.Reset(GetSize());
+        backward.Reset(GetSize());
+        forward.Label(startVertexIndex, 0, -1);
+        backward.Label(endVertexIndex, 0, -1);
+        PushHeap(forward.heap, HeapEntry{0, 0, startVertexIndex});
+        PushHeap(backward.heap, HeapEntry{0, 0, endVertexIndex});
+        int best = startVertexIndex == endVertexIndex ? 0 : INT_MAX;
+        int meet = startVertexIndex == endVertexIndex ? startVertexIndex : -1;
+
+        for (;;) {
+            bool forwardOpen = !forward.heap.empty() && forward.heap.front().key < best;
+            bool backwardOpen = !backward.heap.empty() && backward.heap.front().key < best;
+            if (!forwardOpen && !backwardOpen) {
+                break;
+            }
+            bool forwardSide = forwardOpen && (!backwardOpen || forward.heap.front().key <= backward.heap.front().key);
+            DijkstraWorkspace &own = forwardSide ? forward : backward;
+            DijkstraWorkspace &other = forwardSide ? backward : forward;
+
+            HeapEntry top = PopHeap(own.heap);
+            int u = top.slot;
+            if (top.key != own.GetDistance(u)) {
+                continue;
+            }
+            if (other.IsReached(u) && top.key + other.GetDistance(u) < best) {
+                best = top.key + other.GetDistance(u);
+                meet = u;
+            }
+            bool stalled = false;
+            for (const auto &edge : forwardSide ? DownArcs(u) : UpArcs(u)) {
+                int x = static_cast<int>(edge.GetTarget());
+                if (own.IsReached(x) && own.GetDistance(x) + edge.GetWeight() < top.key) {
+                    stalled = true;
+                    break;
+                }
+            }
+            if (stalled) {
+                continue;
+            }
+            for (const auto &edge : forwardSide ? UpArcs(u) : DownArcs(u)) {
+                int v = static_cast<int>(edge.GetTarget());
+                int newDist = top.key + edge.GetWeight();
+                if (own.GetDistance(v) > newDist) {
+                    own.Label(v, newDist, u);
+                    PushHeap(own.heap, HeapEntry{newDist, newDist, v});
+                }
+            }
+        }
+        return meet;
+    }
+
+    // Distance only, without printing; INT_MAX when a vertex is unknown or there is no path.
+    int GetDistance(T startVertexName, T endVertexName) const
+    {
+        int startVertexIndex = index.Find(startVertexName);
+        int endVertexIndex = index.Find(endVertexName);
+        if (startVertexIndex == -1 || endVertexIndex == -1) {
+            return INT_MAX;
+        }
+        DijkstraWorkspace &forward = ThreadWorkspace(0);
+        DijkstraWorkspace &backward = ThreadWorkspace(1);
+        int meet = QueryIds(startVertexIndex, endVertexIndex, forward, backward);
+        return meet == -1 ? INT_MAX : forward.GetDistance(meet) + backward.GetDistance(meet);
+    }
+
+    // Prints like Graph::Dijkstra. The Path has the unpacked vertices and the length but no distance array.
+    Path<T> ShortestPath(T startVertexName, T endVertexName) const
+    {
+        int startVertexIndex, endVertexIndex;
+        if (!ResolveEndpoints(*this, startVertexName, endVertexName, startVertexIndex, endVertexIndex)) {
+            return Path<T>();
+        }
+        DijkstraWorkspace &forward = ThreadWorkspace(0);
+        DijkstraWorkspace &backward = ThreadWorkspace(1);
+        int meet = QueryIds(startVertexIndex, endVertexIndex, forward, backward);
+        int length = meet == -1 ? INT_MAX : forward.GetDistance(meet) + backward.GetDistance(meet);
+        if (!ReportDistance(startVertexName, endVertexName, length)) {
+            return Path<T>();
+        }
+
+        // Hierarchy path start .. meet .. end; the backward predecessor of a vertex is its successor.
+        std::vector<int> hops;
+        for (int at = meet; at != -1; at = forward.GetPrevious(at)) {
+            hops.push_back(at);
+        }
+        std::reverse(hops.begin(), hops.end());
+        for (int at = backward.GetPrevious(meet); at != -1; at = backward.GetPrevious(at)) {
+            hops.push_back(at);
+        }
+
+        // Each shortcut from -> to is replaced by from -> middle -> to until only original arcs are left.
+        DynamicArray<T> path;
+        path.push_back(index.GetName(hops[0]));
+        std::vector<std::pair<int, int>> pending;
+        for (size_t i = hops.size() - 1; i > 0; i--) {
+            pending.push_back(std::make_pair(hops[i - 1], hops[i]));
+        }
+        while (!pending.empty()) {
+            std::pair<int, int> arc = pending.back();
+            pending.pop_back();
+            int middle = MiddleOf(arc.first, arc.second);
+            if (middle == -1) {
+                path.push_back(index.GetName(arc.second));
+            } else {
+                pending.push_back(std::make_pair(middle, arc.second));
+                pending.push_back(std::make_pair(arc.first, middle));
+            }
+        }
+        return Path<T>(DynamicArray<int>(0), std::move(path), length);
+    }
+
+    // Complete upward search from slot (over the up arcs forward, the down arcs backward) with stall-on-demand;
+    // visit(vertex, distance) is called for every settled vertex that is not stalled.
+    template<typename Visit>
+    void UpwardSearch(int slot, bool forwardSide, DijkstraWorkspace &workspace, Visit &&visit) const
+    {
+        workspace.Reset(GetSize());
+        workspace.Label(slot, 0, -1);
+        PushHeap(workspace.heap, HeapEntry{0, 0, slot});
+        while (!workspace.heap.empty()) {
+            HeapEntry top = PopHeap(workspace.heap);
+            int u = top.slot;
+            if (top.key != workspace.GetDistance(u)) {
+                continue;
+            }
+            bool stalled = false;
+            for (const auto &edge : forwardSide ? DownArcs(u) : UpArcs(u)) {
+                int x = static_cast<int>(edge.GetTarget());
+                if (workspace.IsReached(x) && workspace.GetDistance(x) + edge.GetWeight() < top.key) {
+                    stalled = true;
+                    break;
+                }
+            }
+            if (stalled) {
+                continue;
+            }
+            visit(u, top.key);
+            for (const auto &edge : forwardSide ? UpArcs(u) : DownArcs(u)) {
+                int v = static_cast<int>(edge.GetTarget());
+                int newDist = top.key + edge.GetWeight();
+                if (workspace.GetDistance(v) > newDist) {
+                    workspace.Label(v, newDist, u);
+                    PushHeap(workspace.heap, HeapEntry{newDist, newDist, v});
+                }
+            }
+        }
+    }
+
+    // Many-to-many distances with buckets: the backward upward search of every target leaves (target, distance)
+    // in a bucket at each vertex it settles, then the forward upward search of every source scans the buckets
+    // of the vertices it settles. Both rounds run in parallel on the pool. Entry (i, j) is the distance from
+    // sources[i] to targets[j], INT_MAX when either is unknown or there is no path.
+    DistanceMatrix DistanceTable(ArrayView<T> sources, ArrayView<T> targets, ThreadPool &pool = ThreadPool::Shared()) const
+    {
+        DistanceMatrix result(sources.get_size(), targets.get_size());
+        std::vector<std::vector<std::pair<int, int>>> spaces(targets.get_size());
+        pool.ParallelFor(targets.get_size(), [&](size_t j) {
+            int slot = index.Find(targets[j]);
+            if (slot != -1) {
+                UpwardSearch(slot, false, ThreadWorkspace(), [&](int v, int distance) { spaces[j].push_back(std::make_pair(v, distance)); });
+            }
+        });
+
+        // Buckets of all vertices in one array: bucket v is entries[bucketOffsets[v] .. bucketOffsets[v + 1]).
+        std::vector<uint32_t> bucketOffsets(GetSize() + 1, 0);
+        for (const auto &space : spaces) {
+            for (const auto &entry : space) {
+                ++bucketOffsets[entry.first + 1];
+            }
+        }
+        for (int v = 0; v < GetSize(); v++) {
+            bucketOffsets[v + 1] += bucketOffsets[v];
+        }
+        std::vector<std::pair<int, int>> entries(bucketOffsets[GetSize()]);
+        std::vector<uint32_t> next(bucketOffsets.begin(), bucketOffsets.end() - 1);
+        for (size_t j = 0; j < spaces.size(); j++) {
+            for (const auto &entry : spaces[j]) {
+                entries[next[entry.first]++] = std::make_pair(static_cast<int>(j), entry.second);
+            }
+        }
+
+        pool.ParallelFor(sources.get_size(), [&](size_t i) {
+            int slot = index.Find(sources[i]);
+            if (slot == -1) {
+                return;
+            }
+            int *row = result.Row(i);
+            UpwardSearch(slot, true, ThreadWorkspace(), [&](int v, int distance) {
+                for (uint32_t k = bucketOffsets[v]; k < bucketOffsets[v + 1]; k++) {
+                    row[entries[k].first] = std::min(row[entries[k].first], distance + entries[k].second);
+                }
+            });
+        });
+        return result;
+    }
+};
+
+// Prints the preprocessing figures and the average time of numQueries random queries against Dijkstra
+// on the graph the hierarchy was built from.
+template<typename G, typename T>
+void ReportContractionHierarchy(const G &graph, const ContractionHierarchy<T> &hierarchy, int numQueries)
+{
+    const ContractionStats &stats = hierarchy.GetStats();
+    std::cout << "Contraction hierarchy: " << hierarchy.GetSize() << " vertices, " << stats.originalArcs << " arcs, "
+              << stats.shortcuts << " shortcuts" << std::endl;
+    std::cout << "Preprocessing: " << stats.preprocessingMilliseconds << " ms, " << stats.memoryBytes / 1024 << " KB" << std::endl;
+    if (graph.GetSize() == 0 || hierarchy.GetSize() != graph.GetSize() || numQueries <= 0) {
+        return;
+    }
+
+    std::mt19937 rng(12345);
+    std::uniform_int_distribution<int> pick(0, graph.GetSize() - 1);
+    std::vector<std::pair<int, int>> queries;
+    for (int i = 0; i < numQueries; i++) {
+        queries.push_back(std::make_pair(pick(rng), pick(rng)));
+    }
+
+    DijkstraWorkspace &forward = ThreadWorkspace(0);
+    DijkstraWorkspace &backward = ThreadWorkspace(1);
+    auto startTime = std::chrono::steady_clock::now();
+    for (const auto &query : queries) {
+        hierarchy.QueryIds(query.first, query.second, forward, backward);
+    }
+    double hierarchyTime = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - startTime).count();
+
+    startTime = std::chrono::steady_clock::now();
+    for (const auto &query : queries) {
+        DijkstraIds(graph, query.first, DijkstraQueue::Auto, forward, StopAtVertex{query.second});
+    }
+    double dijkstraTime = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - startTime).count();
+
+    std::cout << "Average query: " << hierarchyTime / numQueries << " us, Dijkstra: " << dijkstraTime / numQueries
+              << " us, speedup: " << (hierarchyTime > 0 ? dijkstraTime / hierarchyTime : 0) << "x" << std::endl;
+}
+
+#endif // CONTRACTIONHIERARCHY_H
@@ -0,0 +1,266 @@
+#ifndef CSRGRAPH_H
+#define CSRGRAPH_H
+
+#include "DynamicArray.h"
+#include "GraphParts.h"
+#include "VertexIndex.h"
+#include "GraphAlgorithms.h"
+#include "ContractionHierarchy.h"
+#include "LandmarkTable.h"
+#include "DagExecutor.h"
+#include "Path.h"
+
+// Immutable compressed-sparse-row snapshot of a graph: the arcs of slot u are
+// targets/weights[offsets[u] .. offsets[u + 1]). The reverse graph is stored the same way in the
+// in* arrays for backward searches. Slots and names match the source graph at the time of the snapshot.
+template<typename T>
+class CsrGraph
+{
+private:
+    VertexIndex<T> index;
+    DynamicArray<uint32_t> offsets;
+    DynamicArray<uint32_t> targets;
+    DynamicArray<int> weights;
+    DynamicArray<uint32_t> inOffsets;
+    DynamicArray<uint32_t> inSources;
+    DynamicArray<int> inWeights;
+    int minWeight = 0;
+    int maxWeight = 0;
+
+    // Weight bounds and the reverse graph, from the forward arrays.
+    void BuildReverse()
+    {
+        int numVertices = GetSize();
+        for (size_t i = 0; i < weights.get_size(); i++) {
+            minWeight = std::min(minWeight, weights[i]);
+            maxWeight = std::max(maxWeight, weights[i]);
+        }
+
+        // Counting sort of the arcs by target gives the reverse graph.
+        inOffsets = DynamicArray<uint32_t>(numVertices + 1);
+        for (int u = 0; u <= numVertices; u++) {
+            inOffsets[u] = 0;
+        }
+        for (size_t i = 0; i < targets.get_size(); i++) {
+            ++inOffsets[targets[i] + 1];
+        }
+        for (int u = 0; u < numVertices; u++) {
+            inOffsets[u + 1] += inOffsets[u];
+        }
+        inSources = DynamicArray<uint32_t>(targets.get_size());
+        inWeights = DynamicArray<int>(targets.get_size());
+        DynamicArray<uint32_t> next(inOffsets);
+        for (int u = 0; u < numVertices; u++) {
+            for (uint32_t i = offsets[u]; i < offsets[u + 1]; i++) {
+                uint32_t pos = next[targets[i]]++;
+                inSources[pos] = static_cast<uint32_t>(u);
+                inWeights[pos] = weights[i];
+            }
+        }
+    }
+public:
+    CsrGraph() = default;
+
+    // Takes arrays that are already in the layout above; offsets has index.GetSize() + 1 entries.
+    CsrGraph(const VertexIndex<T> &index_, DynamicArray<uint32_t> &&offsets_, DynamicArray<uint32_t> &&targets_, DynamicArray<int> &&weights_)
+        : index(index_), offsets(std::move(offsets_)), targets(std::move(targets_)), weights(std::move(weights_))
+    {
+        BuildReverse();
+    }
+
+    template<typename G>
+    explicit CsrGraph(const G &graph) : index(graph.GetIndex()), offsets(graph.GetSize() + 1)
+    {
+        int numVertices = graph.GetSize();
+        offsets[0] = 0;
+        for (int u = 0; u < numVertices; u++) {
+            offsets[u + 1] = offsets[u] + static_cast<uint32_t>(graph.OutEdges(u).size());
+        }
+
+        targets = DynamicArray<uint32_t>(offsets[numVertices]);
+        weights = DynamicArray<int>(offsets[numVertices]);
+        for (int u = 0; u < numVertices; u++) {
+            uint32_t pos = offsets[u];
+            for (const auto &edge : graph.OutEdges(u)) {
+                targets[pos] = edge.GetTarget();
+                weights[pos] = edge.GetWeight();
+                ++pos;
+            }
+        }
+        BuildReverse();
+    }
+
+    int GetSize() const
+    {
+        return index.GetSize();
+    }
+
+    int GetEdgeCount() const
+    {
+        return static_cast<int>(targets.get_size());
+    }
+
+    bool SearchVertex(T vertexName) const
+    {
+        return index.Find(vertexName) != -1;
+    }
+
+    int FindSlot(T vertexName) const
+    {
+        return index.Find(vertexName);
+    }
+
+    T GetVertexName(uint32_t slot) const
+    {
+        return index.GetName(static_cast<int>(slot));
+    }
+
+    const VertexIndex<T>& GetIndex() const
+    {
+        return index;
+    }
+
+    int GetMinWeight() const
+    {
+        return minWeight;
+    }
+
+    int GetMaxWeight() const
+    {
+        return maxWeight;
+    }
+
+    EdgeRange OutEdges(uint32_t slot) const
+    {
+        uint32_t begin = offsets[slot];
+        return EdgeRange(targets.get_data() + begin, weights.get_data() + begin, offsets[slot + 1] - begin);
+    }
+
+    EdgeRange InEdges(uint32_t slot) const
+    {
+        uint32_t begin = inOffsets[slot];
+        return EdgeRange(inSources.get_data() + begin, inWeights.get_data() + begin, inOffsets[slot + 1] - begin);
+    }
+
+    Path<T> Dijkstra(T startVertexName, T endVertexName) const
+    {
+        return DijkstraSearch(*this, startVertexName, endVertexName);
+    }
+
+    Path<T> Dijkstra(T startVertexName, T endVertexName, DijkstraWorkspace &workspace) const
+    {
+        return DijkstraSearch(*this, startVertexName, endVertexName, workspace);
+    }
+
+    DynamicArray<Path<T>> DijkstraBatch(ArrayView<std::pair<T, T>> queries, ThreadPool &pool = ThreadPool::Shared()) const
+    {
+        return DijkstraBatchSearch(*this, queries, pool);
+    }
+
+    Path<T> DeltaStepping(T startVertexName, T endVertexName, int delta = 0, ThreadPool &pool = ThreadPool::Shared()) const
+    {
+        return DeltaSteppingSearch(*this, startVertexName, endVertexName, delta, pool);
+    }
+
+    DistanceMatrix DistanceTable(ArrayView<T> sources, ArrayView<T> targets, ThreadPool &pool = ThreadPool::Shared()) const
+    {
+        return DistanceTableSearch(*this, sources, targets, pool);
+    }
+
+    DistanceMatrix AllPairsShortestPaths(ThreadPool &pool = ThreadPool::Shared()) const
+    {
+        return AllPairsSearch(*this, pool);
+    }
+
+    Path<T> DialDijkstra(T startVertexName, T endVertexName) const
+    {
+        return DijkstraSearch(*this, startVertexName, endVertexName, DijkstraQueue::Buckets);
+    }
+
+    ShortestPathTree<T> ShortestPaths(T sourceVertexName) const
+    {
+        return ShortestPathTreeSearch(*this, sourceVertexName);
+    }
+
+    DynamicArray<Path<T>> KShortestPaths(T startVertexName, T endVertexName, int k) const
+    {
+        return KShortestPathsSearch(*this, startVertexName, endVertexName, k);
+    }
+
+    DynamicArray<std::pair<T, int>> WithinDistance(T sourceVertexName, int radius) const
+    {
+        return WithinDistanceSearch(*this, sourceVertexName, radius);
+    }
+
+    Path<T> BidirectionalDijkstra(T startVertexName, T endVertexName) const
+    {
+        return BidirectionalSearch(*this, startVertexName, endVertexName);
+    }
+
+    template<typename Heuristic>
+    Path<T> AStar(T startVertexName, T endVertexName, Heuristic &&heuristic) const
+    {
+        return AStarSearch(*this, startVertexName, endVertexName, heuristic);
+    }
+
+    ContractionHierarchy<T> BuildContractionHierarchy() const
+    {
+        return ContractionHierarchy<T>(*this);
+    }
+
+    LandmarkTable BuildLandmarks(int count) const
+    {
+        return LandmarkTable(*this, count);
+    }
+
+    Path<T> LandmarkAStar(T startVertexName, T endVertexName, const LandmarkTable &landmarks) const
+    {
+        return LandmarkSearch(*this, startVertexName, endVertexName, landmarks);
+    }
+
+    // Order or cycle in one iterative pass (see TopologicalSortIds).
+    TopologicalOrder<T> SortTopologically() const
+    {
+        return TopologicalOrderSearch<T>(*this);
+    }
+
+    DynamicArray<DynamicArray<T>> TopologicalLevels(ThreadPool &pool = ThreadPool::Shared()) const
+    {
+        return TopologicalLevelsSearch<T>(*this, pool);
+    }
+
+    template<typename Task>
+    bool ExecuteTopologically(Task &&task, ThreadPool &pool = ThreadPool::Shared()) const
+    {
+        bool acyclic = ExecuteDagIds(*this, [&](int slot) { task(GetVertexName(slot)); }, pool);
+        if (!acyclic) {
+            std::cout << "Error: The graph contains a cycle. Topological sort is not possible." << std::endl;
+        }
+        return acyclic;
+    }
+
+    void topologicalSort(DynamicArray<T>& result) const
+    {
+        TopologicalSort(*this, result);
+    }
+
+    // Like Graph::DagShortestPaths, but the order is computed on every call.
+    ShortestPathTree<T> DagShortestPaths(T sourceVertexName) const
+    {
+        std::shared_ptr<const DagOrder> dag = ComputeDagOrder(*this);
+        return DagPathTreeSearch(*this, sourceVertexName, dag.get(), false);
+    }
+
+    ShortestPathTree<T> DagLongestPaths(T sourceVertexName) const
+    {
+        std::shared_ptr<const DagOrder> dag = ComputeDagOrder(*this);
+        return DagPathTreeSearch(*this, sourceVertexName, dag.get(), true);
+    }
+
+    bool hasCycle() const
+    {
+        return HasCycle(*this);
+    }
+};
+
+#endif // CSRGRAPH_H
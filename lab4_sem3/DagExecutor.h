@@ -0,0 +1,134 @@
+#ifndef DAGEXECUTOR_H
+#define DAGEXECUTOR_H
+
+#include "GraphAlgorithms.h"
+#include "ThreadPool.h"
+#include <deque>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <vector>
+
+// Ready vertices of one thread. The owner works on the newest (its successors are likely still in cache);
+// other threads steal the oldest, which tends to have the most work behind it.
+struct alignas(64) StealingQueue
+{
+    std::mutex mutex;
+    std::deque<int> slots;
+
+    void Push(int slot)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        slots.push_back(slot);
+    }
+
+    bool PopNewest(int &slot)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (slots.empty()) {
+            return false;
+        }
+        slot = slots.back();
+        slots.pop_back();
+        return true;
+    }
+
+    bool StealOldest(int &slot)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (slots.empty()) {
+            return false;
+        }
+        slot = slots.front();
+        slots.pop_front();
+        return true;
+    }
+};
+
+// Runs task(slot) for every vertex of g, each one only after the tasks of all its predecessors have returned,
+// on the pool's threads and the calling one. A vertex becomes ready when the atomic count of its unfinished
+// predecessors drops to zero and goes to the queue of the thread that finished the last of them; a thread
+// without ready vertices steals from the others, and sleeps while there is nothing to steal. The run holds
+// every pool thread, so a ParallelFor inside a task runs on the calling thread. Returns false without
+// running anything when g has a cycle. task is called concurrently and must not throw.
+template<typename G, typename Task>
+bool ExecuteDagIds(const G &g, Task &&task, ThreadPool &pool)
+{
+    std::vector<int> order, cycle;
+    if (!TopologicalSortIds(g, order, cycle)) {
+        return false;
+    }
+    size_t numVertices = static_cast<size_t>(g.GetSize());
+    std::vector<std::atomic<int>> waiting(numVertices);
+    for (auto &count : waiting) {
+        count.store(0, std::memory_order_relaxed);
+    }
+    for (size_t u = 0; u < numVertices; u++) {
+        for (const auto &edge : g.OutEdges(static_cast<uint32_t>(u))) {
+            waiting[edge.GetTarget()].fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    size_t numWorkers = pool.GetThreadCount() + 1;
+    std::vector<StealingQueue> queues(numWorkers);
+    size_t next = 0;
+    for (size_t v = 0; v < numVertices; v++) {
+        if (waiting[v].load(std::memory_order_relaxed) == 0) {
+            queues[next++ % numWorkers].slots.push_back(static_cast<int>(v));
+        }
+    }
+
+    std::atomic<size_t> finished{0};
+    // ready counts the queued vertices. A thread that found none sleeps on idle; sleeping tells the threads
+    // that queue a vertex whether someone has to be woken. Both are sequentially consistent, so either the
+    // sleeper sees the new vertex or the thread that queued it sees the sleeper.
+    std::atomic<size_t> ready{next};
+    std::atomic<size_t> sleeping{0};
+    std::mutex idleMutex;
+    std::condition_variable idle;
+    auto wake = [&](bool all) {
+        {
+            std::lock_guard<std::mutex> lock(idleMutex);
+        }
+        if (all) {
+            idle.notify_all();
+        } else {
+            idle.notify_one();
+        }
+    };
+    // If the pool is busy, one thread may end up running several of these loops one after another; the first
+    // one then steals everything and the rest return at once.
+    pool.ParallelFor(numWorkers, [&](size_t self) {
+        while (finished.load(std::memory_order_acquire) < numVertices) {
+            int u;
+            bool found = queues[self].PopNewest(u);
+            for (size_t k = 1; !found && k < numWorkers; k++) {
+                found = queues[(self + k) % numWorkers].StealOldest(u);
+            }
+            if (!found) {
+                std::unique_lock<std::mutex> lock(idleMutex);
+                ++sleeping;
+                idle.wait(lock, [&] { return ready > 0 || finished == numVertices; });
+                --sleeping;
+                continue;
+            }
+            --ready;
+            task(u);
+            for (const auto &edge : g.OutEdges(static_cast<uint32_t>(u))) {
+                if (waiting[edge.GetTarget()].fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                    ++ready;
+                    queues[self].Push(static_cast<int>(edge.GetTarget()));
+                    if (sleeping > 0) {
+                        wake(false);
+                    }
+                }
+            }
+            if (finished.fetch_add(1, std::memory_order_acq_rel) + 1 == numVertices) {
+                wake(true);
+            }
+        }
+    });
+    return true;
+}
+
+#endif // DAGEXECUTOR_H
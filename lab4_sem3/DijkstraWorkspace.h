@@ -0,0 +1,116 @@
+#ifndef DIJKSTRAWORKSPACE_H
+#define DIJKSTRAWORKSPACE_H
+
+#include "DynamicArray.h"
+#include <vector>
+#include <climits>
+#include <cstdint>
+
+struct HeapEntry
+{
+    int key;
+    int distance;
+    int slot;
+
+    bool operator>(const HeapEntry &other) const
+    {
+        return key > other.key || (key == other.key && slot > other.slot);
+    }
+};
+
+// Scratch state for one search at a time: distance/predecessor labels, the heap and the buckets.
+// A label is valid only if its stamp equals the current generation, so Reset is O(1) instead of
+// refilling V entries; only the first query on a larger graph (or a generation wrap) touches every slot.
+// Not thread-safe: keep one per thread (ThreadWorkspace) or pass one in explicitly.
+class DijkstraWorkspace
+{
+private:
+    DynamicArray<int> dist;
+    DynamicArray<int> prev;
+    DynamicArray<uint32_t> stamp;
+    uint32_t generation = 0;
+    std::vector<int> touched;
+
+public:
+    std::vector<HeapEntry> heap;
+    std::vector<std::vector<int>> buckets;
+
+    DijkstraWorkspace() : dist(0), prev(0), stamp(0) {}
+
+    void Reset(int numVertices)
+    {
+        size_t n = static_cast<size_t>(numVertices);
+        if (stamp.get_size() < n) {
+            dist = DynamicArray<int>(n);
+            prev = DynamicArray<int>(n);
+            stamp = DynamicArray<uint32_t>(n, 0);
+            generation = 0;
+        }
+        if (++generation == 0) {
+            for (size_t i = 0; i < stamp.get_size(); i++) {
+                stamp[i] = 0;
+            }
+            generation = 1;
+        }
+        touched.clear();
+        heap.clear();
+    }
+
+    bool IsReached(int slot) const
+    {
+        return stamp[slot] == generation;
+    }
+
+    int GetDistance(int slot) const
+    {
+        return IsReached(slot) ? dist[slot] : INT_MAX;
+    }
+
+    int GetPrevious(int slot) const
+    {
+        return IsReached(slot) ? prev[slot] : -1;
+    }
+
+    void Label(int slot, int distance, int previous)
+    {
+        if (!IsReached(slot)) {
+            stamp[slot] = generation;
+            touched.push_back(slot);
+        }
+        dist[slot] = distance;
+        prev[slot] = previous;
+    }
+
+    // Slots labelled since the last Reset, in first-reached order.
+    const std::vector<int>& GetTouched() const
+    {
+        return touched;
+    }
+
+    DynamicArray<int> ExportDistances(int numVertices) const
+    {
+        DynamicArray<int> result(static_cast<size_t>(numVertices), INT_MAX);
+        for (int slot : touched) {
+            result[slot] = dist[slot];
+        }
+        return result;
+    }
+
+    DynamicArray<int> ExportPredecessors(int numVertices) const
+    {
+        DynamicArray<int> result(static_cast<size_t>(numVertices), -1);
+        for (int slot : touched) {
+            result[slot] = prev[slot];
+        }
+        return result;
+    }
+};
+
+// Per-thread workspaces used by the queries that do not take one; bidirectional searches use both.
+inline DijkstraWorkspace &ThreadWorkspace(int which = 0)
+{
+    static thread_local DijkstraWorkspace workspaces[2];
+    return workspaces[which];
+}
+
+#endif // DIJKSTRAWORKSPACE_H
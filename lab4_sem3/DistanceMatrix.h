@@ -0,0 +1,66 @@
+#ifndef DISTANCEMATRIX_H
+#define DISTANCEMATRIX_H
+
+#include "DynamicArray.h"
+#include "ArrayView.h"
+#include <algorithm>
+#include <climits>
+
+// rows x cols distances in one row-major block; INT_MAX marks an unreachable pair.
+class DistanceMatrix
+{
+private:
+    size_t rows = 0;
+    size_t cols = 0;
+    DynamicArray<int> values;
+
+public:
+    DistanceMatrix() : values(0) {}
+
+    DistanceMatrix(size_t rows_, size_t cols_, int fill = INT_MAX) : rows(rows_), cols(cols_), values(rows_ * cols_)
+    {
+        std::fill(values.get_data(), values.get_data() + rows * cols, fill);
+    }
+
+    size_t GetRows() const
+    {
+        return rows;
+    }
+
+    size_t GetCols() const
+    {
+        return cols;
+    }
+
+    int &operator()(size_t row, size_t col)
+    {
+        return values.get_data()[row * cols + col];
+    }
+
+    int operator()(size_t row, size_t col) const
+    {
+        return values.get_data()[row * cols + col];
+    }
+
+    int *Row(size_t row)
+    {
+        return values.get_data() + row * cols;
+    }
+
+    ArrayView<int> GetRow(size_t row) const
+    {
+        return ArrayView<int>(values.get_data() + row * cols, cols);
+    }
+
+    int *GetData()
+    {
+        return values.get_data();
+    }
+
+    const int *GetData() const
+    {
+        return values.get_data();
+    }
+};
+
+#endif // DISTANCEMATRIX_H
@@ -20,7 +20,7 @@ public:
     DynamicArray(const size_t size, T default_value);
     DynamicArray(const std::initializer_list<T> list);
     DynamicArray(const DynamicArray<T> &input_vector);
-    DynamicArray(DynamicArray<T> &&input_vector);
+    DynamicArray(DynamicArray<T> &&input_vector) noexcept;
 
     ~DynamicArray() noexcept;
 
@@ -38,14 +38,18 @@ public:
     bool is_empty() const noexcept;
 
     size_t get_size() const noexcept;
+    T *get_data() noexcept;
+    const T *get_data() const noexcept;
 
     T &operator[](const size_t index);
-    T operator[](const size_t index) const;
+    const T &operator[](const size_t index) const;
     DynamicArray &operator=(const DynamicArray<T> &other);
-    DynamicArray &operator=(DynamicArray<T> &&other);
+    DynamicArray &operator=(DynamicArray<T> &&other) noexcept;
 
     iterator begin() noexcept;
     iterator end() noexcept;
+    iterator begin() const noexcept;
+    iterator end() const noexcept;
 
     iterator cbegin() const noexcept;
     iterator cend() const noexcept;
@@ -84,7 +88,7 @@ template <typename T> DynamicArray<T>::DynamicArray(const DynamicArray<T> &input
     *this = input_vector;
 }
 
-template <typename T> DynamicArray<T>::DynamicArray(DynamicArray<T> &&input_vector)
+template <typename T> DynamicArray<T>::DynamicArray(DynamicArray<T> &&input_vector) noexcept
 {
     *this = std::move(input_vector);
 }
@@ -97,7 +101,7 @@ template <typename T> DynamicArray<T>::~DynamicArray() noexcept
 template <typename T> void DynamicArray<T>::push_back(const T &value)
 {
     if (size == capacity)
-        resize(capacity * 2);
+        resize(capacity == 0 ? 1 : capacity * 2);
     data[size++] = value;
 }
 
@@ -152,7 +156,7 @@ template <typename T> typename DynamicArray<T>::iterator DynamicArray<T>::erase(
 {
     if (position > end() || position < begin())
         throw std::invalid_argument("Invalid position");
-    std::copy(position + 1, end(), position);
+    std::move(position + 1, end(), position);
     --size;
     return iterator(position);
 }
@@ -172,7 +176,7 @@ template <typename T> void DynamicArray<T>::resize(const size_t new_size)
     if (new_size < size)
         throw std::runtime_error("Cannot resize to a smaller size");
     T *new_data = new T[new_size];
-    std::copy(data, data + size, new_data);
+    std::move(data, data + size, new_data);
     capacity = new_size;
     delete[] data;
     data = new_data;
@@ -188,6 +192,16 @@ template <typename T> size_t DynamicArray<T>::get_size() const noexcept
     return size;
 }
 
+template <typename T> T *DynamicArray<T>::get_data() noexcept
+{
+    return data;
+}
+
+template <typename T> const T *DynamicArray<T>::get_data() const noexcept
+{
+    return data;
+}
+
 template <typename T> T &DynamicArray<T>::operator[](const size_t index)
 {
     if (index >= size)
@@ -195,7 +209,7 @@ template <typename T> T &DynamicArray<T>::operator[](const size_t index)
     return data[index];
 }
 
-template <typename T> T DynamicArray<T>::operator[](const size_t index) const
+template <typename T> const T &DynamicArray<T>::operator[](const size_t index) const
 {
     if (index >= size)
         throw std::out_of_range("Index out of range!");
@@ -216,7 +230,7 @@ template <typename T> DynamicArray<T> &DynamicArray<T>::operator=(const DynamicA
     return *this;
 }
 
-template <typename T> DynamicArray<T> &DynamicArray<T>::operator=(DynamicArray<T> &&other)
+template <typename T> DynamicArray<T> &DynamicArray<T>::operator=(DynamicArray<T> &&other) noexcept
 {
     if (this == &other)
         return *this;
@@ -240,6 +254,16 @@ template <typename T> typename DynamicArray<T>::iterator DynamicArray<T>::end()
     return iterator(data + size);
 }
 
+template <typename T> typename DynamicArray<T>::iterator DynamicArray<T>::begin() const noexcept
+{
+    return iterator(data);
+}
+
+template <typename T> typename DynamicArray<T>::iterator DynamicArray<T>::end() const noexcept
+{
+    return iterator(data + size);
+}
+
 template <typename T> typename DynamicArray<T>::iterator DynamicArray<T>::cbegin() const noexcept
 {
     return iterator(data);
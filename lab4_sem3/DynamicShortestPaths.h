@@ -0,0 +1,264 @@
+#ifndef DYNAMICSHORTESTPATHS_H
+#define DYNAMICSHORTESTPATHS_H
+
+#include "Graph.h"
+#include "GraphListener.h"
+#include "GraphAlgorithms.h"
+#include <vector>
+#include <climits>
+
+// Shortest-path tree from one source that stays current while the graph changes (Ramalingam-Reps).
+// It registers itself as a listener of the graph and repairs only what a change affects:
+//  - a new arc u -> v that shortens v starts a Dijkstra from v that only visits improved vertices;
+//  - removing a tree arc u -> v invalidates the subtree of v, which is then re-seeded from its unaffected
+//    in-neighbours and settled again; removing any other arc changes nothing.
+// Both cost time in the size of the changed region and its arcs. Removing a vertex renumbers the
+// slots above it and therefore costs O(V). Needs non-negative weights; after a negative arc the tree
+// stops following the graph until Rebuild() is called on a graph without one.
+template<typename T>
+class DynamicShortestPaths : public GraphListener
+{
+private:
+    Graph<T> *graph;
+    T sourceName;
+    int source = -1;
+    bool valid = false;
+    std::vector<int> dist;
+    std::vector<int> prev;
+    std::vector<bool> affected;
+    std::vector<int> region;
+    std::vector<HeapEntry> heap;
+    size_t lastUpdateSize = 0;
+
+    void Label(int slot, int distance, int previous)
+    {
+        dist[slot] = distance;
+        prev[slot] = previous;
+        PushHeap(heap, HeapEntry{distance, distance, slot});
+    }
+
+    // Dijkstra over the queued vertices; only labels that improve are touched.
+    void Settle()
+    {
+        while (!heap.empty()) {
+            HeapEntry top = PopHeap(heap);
+            int u = top.slot;
+            if (top.key != dist[u]) {
+                continue;
+            }
+            ++lastUpdateSize;
+            for (const auto &edge : graph->OutEdges(u)) {
+                int v = static_cast<int>(edge.GetTarget());
+                int newDist = top.key + edge.GetWeight();
+                if (newDist < dist[v]) {
+                    Label(v, newDist, u);
+                }
+            }
+        }
+    }
+
+    // Recomputes the union of the subtrees of roots, whose tree arcs from above are gone.
+    void RepairSubtrees(const std::vector<int> &roots)
+    {
+        region.clear();
+        for (int root : roots) {
+            affected[root] = true;
+            region.push_back(root);
+        }
+        for (size_t i = 0; i < region.size(); i++) {
+            for (const auto &edge : graph->OutEdges(region[i])) {
+                int child = static_cast<int>(edge.GetTarget());
+                if (prev[child] == region[i] && !affected[child]) {
+                    affected[child] = true;
+                    region.push_back(child);
+                }
+            }
+        }
+        for (int x : region) {
+            dist[x] = INT_MAX;
+            prev[x] = -1;
+        }
+        for (int x : region) {
+            for (const auto &edge : graph->InEdges(x)) {
+                int p = static_cast<int>(edge.GetTarget());
+                if (!affected[p] && dist[p] != INT_MAX && dist[p] + edge.GetWeight() < dist[x]) {
+                    dist[x] = dist[p] + edge.GetWeight();
+                    prev[x] = p;
+                }
+            }
+            if (dist[x] != INT_MAX) {
+                PushHeap(heap, HeapEntry{dist[x], dist[x], x});
+            }
+        }
+        for (int x : region) {
+            affected[x] = false;
+        }
+        Settle();
+    }
+
+    void Invalidate()
+    {
+        std::cout << "Dynamic shortest paths require non-negative weights." << std::endl;
+        valid = false;
+    }
+
+public:
+    DynamicShortestPaths(Graph<T> &graph_, T sourceVertexName) : graph(&graph_), sourceName(sourceVertexName)
+    {
+        graph->AddListener(this);
+        Rebuild();
+    }
+
+    DynamicShortestPaths(const DynamicShortestPaths &) = delete;
+    DynamicShortestPaths &operator=(const DynamicShortestPaths &) = delete;
+
+    ~DynamicShortestPaths() override
+    {
+        if (graph != nullptr) {
+            graph->RemoveListener(this);
+        }
+    }
+
+    // Full search from the source, as after construction.
+    void Rebuild()
+    {
+        valid = false;
+        dist.clear();
+        prev.clear();
+        if (graph == nullptr) {
+            return;
+        }
+        source = graph->FindSlot(sourceName);
+        if (source == -1) {
+            std::cout << "Start vertex not found." << std::endl;
+            return;
+        }
+        if (graph->GetMinWeight() < 0) {
+            Invalidate();
+            return;
+        }
+        int numVertices = graph->GetSize();
+        DijkstraWorkspace &workspace = ThreadWorkspace();
+        DijkstraIds(*graph, source, DijkstraQueue::Auto, workspace, StopAtVertex{-1});
+        dist.resize(numVertices);
+        prev.resize(numVertices);
+        affected.assign(numVertices, false);
+        for (int v = 0; v < numVertices; v++) {
+            dist[v] = workspace.GetDistance(v);
+            prev[v] = workspace.GetPrevious(v);
+        }
+        lastUpdateSize = workspace.GetTouched().size();
+        valid = true;
+    }
+
+    // False when the source or the graph is gone, or after a negative arc.
+    bool IsValid() const
+    {
+        return valid;
+    }
+
+    T GetSource() const
+    {
+        return sourceName;
+    }
+
+    // Vertices settled again by the last change (all reachable ones after Rebuild).
+    size_t GetLastUpdateSize() const
+    {
+        return lastUpdateSize;
+    }
+
+    // INT_MAX when the target is unknown or unreachable.
+    int GetDistance(T target) const
+    {
+        int slot = valid ? graph->FindSlot(target) : -1;
+        return slot == -1 ? INT_MAX : dist[slot];
+    }
+
+    // Empty when the target is unknown or unreachable.
+    DynamicArray<T> GetPathTo(T target) const
+    {
+        DynamicArray<T> path;
+        if (GetDistance(target) == INT_MAX) {
+            return path;
+        }
+        for (int at = graph->FindSlot(target); at != -1; at = prev[at]) {
+            path.push_back(graph->GetVertexName(at));
+        }
+        std::reverse(path.begin(), path.end());
+        return path;
+    }
+
+    void OnVertexAdded(int slot) override
+    {
+        if (valid) {
+            dist.insert(dist.begin() + slot, INT_MAX);
+            prev.insert(prev.begin() + slot, -1);
+            affected.insert(affected.begin() + slot, false);
+        }
+    }
+
+    void OnArcAdded(int from, int to, int weight) override
+    {
+        if (!valid) {
+            return;
+        }
+        if (weight < 0) {
+            Invalidate();
+            return;
+        }
+        lastUpdateSize = 0;
+        if (dist[from] != INT_MAX && dist[from] + weight < dist[to]) {
+            Label(to, dist[from] + weight, from);
+            Settle();
+        }
+    }
+
+    void OnArcRemoved(int from, int to) override
+    {
+        if (!valid) {
+            return;
+        }
+        lastUpdateSize = 0;
+        if (prev[to] == from) {
+            RepairSubtrees(std::vector<int>(1, to));
+        }
+    }
+
+    void OnVertexRemoved(int slot) override
+    {
+        if (!valid) {
+            return;
+        }
+        if (slot == source) {
+            valid = false;
+            return;
+        }
+        dist.erase(dist.begin() + slot);
+        prev.erase(prev.begin() + slot);
+        affected.erase(affected.begin() + slot);
+        if (source > slot) {
+            --source;
+        }
+        // The arcs of the removed vertex are already gone, so its children are the roots to repair.
+        std::vector<int> roots;
+        for (size_t v = 0; v < prev.size(); v++) {
+            if (prev[v] == slot) {
+                prev[v] = -1;
+                roots.push_back(static_cast<int>(v));
+            } else if (prev[v] > slot) {
+                --prev[v];
+            }
+        }
+        lastUpdateSize = 0;
+        RepairSubtrees(roots);
+    }
+
+    void OnGraphDetached() override
+    {
+        graph = nullptr;
+        valid = false;
+    }
+};
+
+#endif // DYNAMICSHORTESTPATHS_H
@@ -12,11 +12,50 @@
 #include "Path.h"
 #include <set>
 #include <random>
+#include <climits>
+#include "VertexIndex.h"
+#include "CsrGraph.h"
+#include "GraphAlgorithms.h"
+#include "ContractionHierarchy.h"
+#include "LandmarkTable.h"
+#include "DagExecutor.h"
+#include "StronglyConnectedComponents.h"
+#include "GraphListener.h"
+// Const member functions only read the graph, so any number of threads may call them at the same time as
+// long as none modifies the graph meanwhile. Each thread searches in its own ThreadWorkspace; the
+// single-query methods still print their result, DijkstraBatch does not.
 template<typename T>
 class Graph
 {
 private:
     DynamicArray<Vertex<T>> graph;
+    VertexIndex<T> index;
+    // Bounds on the edge weights ever added; removals do not tighten them.
+    int minWeight = 0;
+    int maxWeight = 0;
+    GraphListenerList listeners;
+    // Topological order while the graph is known to be acyclic; with non-negative weights Dijkstra then relaxes
+    // in that order.
+    mutable DagOrderCache dagOrder;
+
+    void LinkArc(int slot1, int slot2, int weight) {
+        graph[slot1].AddEdgeV(Edge(slot2, weight));
+        graph[slot2].AddInEdge(Edge(slot1, weight));
+        dagOrder.Clear();
+        minWeight = std::min(minWeight, weight);
+        maxWeight = std::max(maxWeight, weight);
+        listeners.Notify([&](GraphListener &listener) { listener.OnArcAdded(slot1, slot2, weight); });
+    }
+
+    void UnlinkArcs(int slot1, int slot2) {
+        bool linked = graph[slot1].FindEdge(slot2) != -1;
+        graph[slot1].RemoveEdgesTo(slot2);
+        graph[slot2].RemoveInEdgesFrom(slot1);
+        if (linked) {
+            dagOrder.ClearIfCyclic();
+            listeners.Notify([&](GraphListener &listener) { listener.OnArcRemoved(slot1, slot2); });
+        }
+    }
 public:
 
     Graph() = default;
@@ -28,16 +67,14 @@ public:
         }
         Vertex<T> vertex(vertexName);
         graph.push_back(vertex);
+        int slot = index.Insert(vertexName);
+        dagOrder.Clear();
+        listeners.Notify([&](GraphListener &listener) { listener.OnVertexAdded(slot); });
         //std::cout << "Vertex " << vertexName << " is added." << std::endl;
     }
 
-    bool SearchVertex(T vertexName) {
-        for (const auto &i : graph) {
-            if (i.GetName() == vertexName) {
-                return true;
-            }
-        }
-        return false;
+    bool SearchVertex(T vertexName) const {
+        return index.Find(vertexName) != -1;
     }
 
 
@@ -51,19 +88,10 @@ public:
             return;
         }
 
-        Edge newEdge(vertexName1, vertexName2, weight);
-        for (auto &i: graph) {
-            if (i.GetName() == vertexName1) {
-                i.AddEdgeV(newEdge);
-            }
-        }
-
-        Edge reverseEdge(vertexName2, vertexName1, weight);
-        for (auto &i: graph) {
-            if (i.GetName() == vertexName2) {
-                i.AddEdgeV(reverseEdge);
-            }
-        }
+        int slot1 = index.Find(vertexName1);
+        int slot2 = index.Find(vertexName2);
+        LinkArc(slot1, slot2, weight);
+        LinkArc(slot2, slot1, weight);
     }
     const DynamicArray<Vertex<T>>& getGraph() const {
         return graph;
@@ -78,64 +106,94 @@ public:
             std::cout << "Arc from " << vertexName1 << " to " << vertexName2 << " already exists." << std::endl;
             return;
         }
-        Edge newEdge(vertexName1, vertexName2, weight);
-        for (auto &i: graph) {
-            if (i.GetName() == vertexName1) {
-                i.AddEdgeV(newEdge);
-                //std::cout << "Added arc from " << vertexName1 << " to " << vertexName2 << " with weight " << weight << std::endl;
-                return;
-            }
-        }
+        LinkArc(index.Find(vertexName1), index.Find(vertexName2), weight);
+        //std::cout << "Added arc from " << vertexName1 << " to " << vertexName2 << " with weight " << weight << std::endl;
     }
 
-    bool SearchEdgeArc(T vertexName1, T vertexName2)
+    bool SearchEdgeArc(T vertexName1, T vertexName2) const
     {
-        for (auto &i: graph)
+        int slot1 = index.Find(vertexName1);
+        int slot2 = index.Find(vertexName2);
+        if (slot1 == -1 || slot2 == -1)
         {
-            for (auto &it: i.GetEdges())
-            {
-                if (it.GetFirst() == vertexName1 && it.GetLast() == vertexName2)
-                {
-                    return true;
-                }
-            }
+            return false;
         }
-        return false;
+        return graph[slot1].FindEdge(slot2) != -1;
     }
 
     void RemoveEdge(T vertexName1, T vertexName2) {
-        for (auto &j: graph) {
-            auto &edges = j.GetEdges();
-            for (auto i = edges.begin(); i != edges.end();) {
-                if (((*i).GetFirst() == vertexName1 && (*i).GetLast() == vertexName2) ||
-                    ((*i).GetFirst() == vertexName2 && (*i).GetLast() == vertexName1)) {
-                    i = edges.erase(i);
-                } else {
-                    ++i;
-                }
-            }
+        int slot1 = index.Find(vertexName1);
+        int slot2 = index.Find(vertexName2);
+        if (slot1 == -1 || slot2 == -1) {
+            return;
         }
+        UnlinkArcs(slot1, slot2);
+        UnlinkArcs(slot2, slot1);
     }
 
     void RemoveVertex(T vertexName) {
-        for (auto& vertex : graph) {
-            auto& edges = vertex.GetEdges();
-            for (auto it = edges.begin(); it != edges.end();) {
-                if ((*it).GetFirst() == vertexName || (*it).GetLast() == vertexName) {
-                    it = edges.erase(it);
-                } else {
-                    ++it;
-                }
-            }
+        int slot = index.Find(vertexName);
+        if (slot == -1) {
+            return;
         }
-        for (auto it = graph.begin(); it != graph.end();) {
-            if ((*it).GetName() == vertexName) {
-                it = graph.erase(it);
-                break;
-            } else {
-                ++it;
-            }
+        // The incoming mirror list names every neighbor that refers to this vertex.
+        for (const auto &edge : graph[slot].GetInEdges()) {
+            graph[edge.GetTarget()].RemoveEdgesTo(slot);
+        }
+        for (const auto &edge : graph[slot].GetEdges()) {
+            graph[edge.GetTarget()].RemoveInEdgesFrom(slot);
+        }
+        graph.erase(graph.begin() + slot);
+        for (auto& vertex : graph) {
+            vertex.ShiftSlotsAbove(slot);
         }
+        index.Erase(vertexName);
+        dagOrder.Clear();
+        listeners.Notify([&](GraphListener &listener) { listener.OnVertexRemoved(slot); });
+    }
+
+    // The listener is told about every later change until it is removed or the graph goes away.
+    void AddListener(GraphListener *listener) {
+        listeners.Add(listener);
+    }
+
+    void RemoveListener(GraphListener *listener) {
+        listeners.Remove(listener);
+    }
+
+    T GetVertexName(uint32_t slot) const
+    {
+        return index.GetName(static_cast<int>(slot));
+    }
+
+    int FindSlot(T vertexName) const
+    {
+        return index.Find(vertexName);
+    }
+
+    const VertexIndex<T>& GetIndex() const
+    {
+        return index;
+    }
+
+    int GetMinWeight() const
+    {
+        return minWeight;
+    }
+
+    int GetMaxWeight() const
+    {
+        return maxWeight;
+    }
+
+    EdgeRange OutEdges(uint32_t slot) const
+    {
+        return graph[slot].GetEdges();
+    }
+
+    EdgeRange InEdges(uint32_t slot) const
+    {
+        return graph[slot].GetInEdges();
     }
 
     int GetSize() const
@@ -145,140 +203,172 @@ public:
 
 
 
-    Path<T> Dijkstra(T startVertexName, T endVertexName) {
-        int numVertices = GetSize();
-        if (numVertices == 0) {
-            std::cout << "Graph is empty." << std::endl;
-            return Path<T>();
+    // When the graph is known to be acyclic (after hasCycle() or a Dag* call) and no weight is negative, the
+    // arcs are relaxed in topological order instead, which gives the same distances without a heap. Either
+    // way only the distances the search needed are set: up to the end vertex on the heap, and only the
+    // vertices between start and end in the topological order on the DAG path.
+    Path<T> Dijkstra(T startVertexName, T endVertexName) const {
+        if (std::shared_ptr<const DagOrder> dag = minWeight >= 0 ? dagOrder.Peek() : nullptr) {
+            return DagPathSearch(*this, startVertexName, endVertexName, *dag);
         }
-        if (!SearchVertex(startVertexName) || !SearchVertex(endVertexName)) {
-            std::cout << "Start or end vertex not found." << std::endl;
-            return Path<T>();
+        return DijkstraSearch(*this, startVertexName, endVertexName);
+    }
+
+    // Reuses the caller's workspace across queries. The Path holds only the vertices; distances
+    // stay readable through workspace.GetDistance(slot) until the workspace runs another search.
+    Path<T> Dijkstra(T startVertexName, T endVertexName, DijkstraWorkspace &workspace) const {
+        if (std::shared_ptr<const DagOrder> dag = minWeight >= 0 ? dagOrder.Peek() : nullptr) {
+            return DagPathSearch(*this, startVertexName, endVertexName, *dag, workspace);
         }
+        return DijkstraSearch(*this, startVertexName, endVertexName, workspace);
+    }
 
-        DynamicArray<int> dist(numVertices, INT_MAX);
-        DynamicArray<int> prev(numVertices, -1);
-        DynamicArray<bool> visited(numVertices, false);
-        int startVertexIndex = -1;
+    // Many (start, end) queries at once, in parallel on pool; result i answers queries[i] (see DijkstraBatchSearch).
+    DynamicArray<Path<T>> DijkstraBatch(ArrayView<std::pair<T, T>> queries, ThreadPool &pool = ThreadPool::Shared()) const {
+        return DijkstraBatchSearch(*this, queries, pool);
+    }
 
-        for (int i = 0; i < numVertices; ++i) {
-            if (graph[i].GetName() == startVertexName) {
-                startVertexIndex = i;
-                break;
-            }
-        }
+    // Parallel alternative to Dijkstra for large graphs with non-negative weights; delta is the bucket width
+    // (0 chooses one from the weights and the average degree). Same output as Dijkstra.
+    Path<T> DeltaStepping(T startVertexName, T endVertexName, int delta = 0, ThreadPool &pool = ThreadPool::Shared()) const {
+        return DeltaSteppingSearch(*this, startVertexName, endVertexName, delta, pool);
+    }
 
-        dist[startVertexIndex] = 0;
+    // Distances from every source to every target as a sources x targets matrix (see DistanceTableSearch);
+    // prints nothing. For repeated tables on an unchanged graph, ContractionHierarchy::DistanceTable is faster.
+    DistanceMatrix DistanceTable(ArrayView<T> sources, ArrayView<T> targets, ThreadPool &pool = ThreadPool::Shared()) const {
+        return DistanceTableSearch(*this, sources, targets, pool);
+    }
 
-        for (int i = 0; i < numVertices - 1; ++i) {
-            int u = -1;
-            for (int j = 0; j < numVertices; ++j) {
-                if (!visited[j] && (u == -1 || dist[j] < dist[u])) {
-                    u = j;
-                }
-            }
-            if (u == -1 || dist[u] == INT_MAX) {
-                break;
-            }
-            visited[u] = true;
-
-            for (const auto &edge : graph[u].GetEdges()) {
-                int vertEnd = -1;
-                for (int k = 0; k < numVertices; ++k) {
-                    if (graph[k].GetName() == edge.GetLast()) {
-                        vertEnd = k;
-                        break;
-                    }
-                }
-                int weight = edge.GetWeight();
-                if (vertEnd != -1 && dist[vertEnd] > dist[u] + weight) {
-                    dist[vertEnd] = dist[u] + weight;
-                    prev[vertEnd] = u;
-                }
-            }
-        }
+    // Every slot to every slot: entry (i, j) is the distance from GetVertexName(i) to GetVertexName(j).
+    // Needs V * V ints, so it is meant for graphs of up to about ten thousand vertices.
+    DistanceMatrix AllPairsShortestPaths(ThreadPool &pool = ThreadPool::Shared()) const {
+        return AllPairsSearch(*this, pool);
+    }
 
-        int endVertexIndex = -1;
-        for (int i = 0; i < numVertices; ++i) {
-            if (graph[i].GetName() == endVertexName) {
-                endVertexIndex = i;
-                break;
-            }
-        }
+    // Bucket-queue variant; Dijkstra already uses it when all weights are in [0, DialMaxWeight].
+    Path<T> DialDijkstra(T startVertexName, T endVertexName) const {
+        return DijkstraSearch(*this, startVertexName, endVertexName, DijkstraQueue::Buckets);
+    }
 
-        if (endVertexIndex == -1 || dist[endVertexIndex] == INT_MAX) {
-            std::cout << "Path from " << startVertexName << " to " << endVertexName << " does not exist." << std::endl;
-            return Path<T>();
-        }
+    ShortestPathTree<T> ShortestPaths(T sourceVertexName) const {
+        return ShortestPathTreeSearch(*this, sourceVertexName);
+    }
 
+    // Up to k shortest loopless paths from start to end, shortest first (see KShortestPathsSearch).
+    DynamicArray<Path<T>> KShortestPaths(T startVertexName, T endVertexName, int k) const {
+        return KShortestPathsSearch(*this, startVertexName, endVertexName, k);
+    }
 
-        std::cout << "Shortest distance from " << startVertexName << " to " << endVertexName << " is: " << dist[endVertexIndex] << std::endl;
+    // (vertex, distance) for every vertex at most radius away from the source, nearest first; only that
+    // neighbourhood is searched.
+    DynamicArray<std::pair<T, int>> WithinDistance(T sourceVertexName, int radius) const {
+        return WithinDistanceSearch(*this, sourceVertexName, radius);
+    }
 
-        DynamicArray<T> path;
-        for (int at = endVertexIndex; at != -1; at = prev[at]) {
-            path.push_back(graph[at].GetName());
-        }
-        std::reverse(path.begin(), path.end());
-        Path<T> item(dist, path);
-        return item;
+    Path<T> BidirectionalDijkstra(T startVertexName, T endVertexName) const {
+        return BidirectionalSearch(*this, startVertexName, endVertexName);
+    }
+
+    // heuristic(vertexName) -> int must never overestimate the distance to endVertexName.
+    template<typename Heuristic>
+    Path<T> AStar(T startVertexName, T endVertexName, Heuristic &&heuristic) const {
+        return AStarSearch(*this, startVertexName, endVertexName, heuristic);
+    }
+
+    // Preprocessing for fast point-to-point queries; the hierarchy does not follow later changes to this graph.
+    ContractionHierarchy<T> BuildContractionHierarchy() const {
+        return ContractionHierarchy<T>(*this);
+    }
+
+    // Lower-bound tables for LandmarkAStar; they do not follow later changes to this graph.
+    LandmarkTable BuildLandmarks(int count) const {
+        return LandmarkTable(*this, count);
+    }
+
+    Path<T> LandmarkAStar(T startVertexName, T endVertexName, const LandmarkTable &landmarks) const {
+        return LandmarkSearch(*this, startVertexName, endVertexName, landmarks);
+    }
+
+    // Order or cycle in one iterative pass (see TopologicalSortIds).
+    TopologicalOrder<T> SortTopologically() const {
+        return TopologicalOrderSearch<T>(*this);
     }
 
-    void topologicalSort(DynamicArray<T>& result) {
-        if (hasCycle()) {
+    // Vertices grouped into topological levels, computed in parallel; the vertices of one level do not depend
+    // on each other. Empty, after an error message, when the graph has a cycle.
+    DynamicArray<DynamicArray<T>> TopologicalLevels(ThreadPool &pool = ThreadPool::Shared()) const {
+        return TopologicalLevelsSearch<T>(*this, pool);
+    }
+
+    // Runs task(vertexName) for every vertex as soon as the tasks of all its predecessors have finished, in
+    // parallel with work stealing (see ExecuteDagIds). Returns false, after an error message, when the graph
+    // has a cycle. The graph must not change while it runs.
+    template<typename Task>
+    bool ExecuteTopologically(Task &&task, ThreadPool &pool = ThreadPool::Shared()) const {
+        bool acyclic = ExecuteDagIds(*this, [&](int slot) { task(GetVertexName(slot)); }, pool);
+        if (!acyclic) {
             std::cout << "Error: The graph contains a cycle. Topological sort is not possible." << std::endl;
-            return;
         }
+        return acyclic;
+    }
 
-        int numVertices = GetSize();
-        DynamicArray<bool> visited(numVertices, false);
-        std::stack<T> stack;
+    // Kept for the menu: appends the order, or prints the cycle.
+    void topologicalSort(DynamicArray<T>& result) const {
+        TopologicalSort(*this, result);
+    }
 
-        for (int i = 0; i < numVertices; i++) {
-            if (!visited[i]) {
-                topologicalSortUtil(graph[i].GetName(), visited, stack);
-            }
-        }
 
-        while (!stack.empty()) {
-            result.push_back(stack.top());
-            stack.pop();
-        }
+    // Component per vertex in one iterative pass (see StronglyConnectedComponentsIds).
+    StronglyConnectedComponents<T> FindStronglyConnectedComponents() const
+    {
+        return StronglyConnectedComponents<T>(*this);
     }
 
+    // The DAG of the components: vertex c of the result is component c (see CondensationIds).
+    CsrGraph<int> BuildCondensation(const StronglyConnectedComponents<T> &components) const
+    {
+        return CondensationIds(*this, components.GetComponentIds(), components.GetCount());
+    }
 
-    bool hasCycle()
+    // Also remembers the answer, so that Dijkstra can use the order until the graph changes (see Dijkstra).
+    bool hasCycle() const
     {
-        int numVertices = (int) graph.get_size();
-        bool *visited = new bool[numVertices];
-        bool *recStack = new bool[numVertices];
-        for (int i = 0; i < numVertices; i++)
-        {
-            visited[i] = false;
-            recStack[i] = false;
-        }
+        return DagOrderOf() == nullptr;
+    }
 
-        for (int i = 0; i < numVertices; i++)
-        {
-            if (hasCycleUtil(i, visited, recStack))
-            {
-                delete[] visited;
-                delete[] recStack;
-                return true;
-            }
-        }
+    // Shortest paths from the source in O(V + E) by relaxing the arcs in topological order, for any weights.
+    // Empty, after an error message, when the graph has a cycle. The order is kept until the graph changes.
+    ShortestPathTree<T> DagShortestPaths(T sourceVertexName) const
+    {
+        std::shared_ptr<const DagOrder> dag = DagOrderOf();
+        return DagPathTreeSearch(*this, sourceVertexName, dag.get(), false);
+    }
 
-        delete[] visited;
-        delete[] recStack;
+    // Longest (critical) paths from the source, the same way; INT_MAX marks the unreachable vertices.
+    ShortestPathTree<T> DagLongestPaths(T sourceVertexName) const
+    {
+        std::shared_ptr<const DagOrder> dag = DagOrderOf();
+        return DagPathTreeSearch(*this, sourceVertexName, dag.get(), true);
+    }
 
-        return false;
+    // Cached topological order; null when the graph has a cycle.
+    std::shared_ptr<const DagOrder> DagOrderOf() const
+    {
+        return dagOrder.Get([this] { return ComputeDagOrder(*this); });
+    }
+
+    // Snapshot for read-heavy workloads; it does not follow later changes to this graph.
+    CsrGraph<T> Freeze() const
+    {
+        return CsrGraph<T>(*this);
     }
 
 
     Vertex<T>& Get(T name_) {
-        for (int i = 0; i < graph.get_size(); i++) {
-            if (graph[i].GetName() == name_) {
-                return graph[i];
-            }
+        int slot = index.Find(name_);
+        if (slot != -1) {
+            return graph[slot];
         }
         throw std::runtime_error("Vertex not found");
     }
@@ -290,12 +380,10 @@ public:
         {
             throw std::runtime_error("Graph is empty");
         }
-        for (int i = 0; i < graph.get_size(); i++)
+        int slot = index.Find(name_);
+        if (slot != -1)
         {
-            if (graph[i].GetName() == name_)
-            {
-                return graph[i];
-            }
+            return graph[slot];
         }
         throw std::runtime_error("Vertex not found");
     }
@@ -329,77 +417,34 @@ public:
         std::cout << "Random graph generated with " << numVertices << " vertices and " << numEdges << " edges." << std::endl;
     }
 
-private:
-
-    void topologicalSortUtil(T vertexName, DynamicArray<bool>& visited, std::stack<T>& stack) {
-        int vertexIndex = -1;
-        for (int i = 0; i < graph.get_size(); i++) {
-            if (graph[i].GetName() == vertexName) {
-                vertexIndex = i;
-                break;
-            }
-        }
-
-        if (vertexIndex == -1) {
+    // Vertex r * cols + c + 1 sits at (r, c) and is joined to its right and lower neighbours by an edge of
+    // weight 1..10, so the Manhattan distance between coordinates is an admissible A* heuristic.
+    void GenerateGridGraph(int rows, int cols, DynamicArray<std::pair<int, int>>& coordinates) {
+        if (rows <= 0 || cols <= 0) {
+            std::cout << "Invalid grid size." << std::endl;
             return;
         }
-
-        visited[vertexIndex] = true;
-
-        for (const auto& edge : graph[vertexIndex].GetEdges()) {
-            T neighbor = edge.GetLast();
-            int neighborIndex = -1;
-
-            for (int i = 0; i < graph.get_size(); i++) {
-                if (graph[i].GetName() == neighbor) {
-                    neighborIndex = i;
-                    break;
-                }
+        for (int r = 0; r < rows; ++r) {
+            for (int c = 0; c < cols; ++c) {
+                AddVertex(r * cols + c + 1);
+                coordinates.push_back(std::make_pair(r, c));
             }
-
-
-            if (neighborIndex != -1 && !visited[neighborIndex]) {
-                topologicalSortUtil(neighbor, visited, stack);
-            }
-        }
-
-        stack.push(vertexName);
-    }
-
-    bool hasCycleUtil(int v, bool visited[], bool *recStack) {
-        if (v < 0 || v >= graph.get_size()) {
-            return false;
         }
-
-        if (!visited[v]) {
-            visited[v] = true;
-            recStack[v] = true;
-
-            for (auto &edge: graph[v].GetEdges()) {
-
-                T neighborName = edge.GetLast();
-                int neighborIndex = -1;
-
-
-                for (int i = 0; i < graph.get_size(); i++) {
-                    if (graph[i].GetName() == neighborName) {
-                        neighborIndex = i;
-                        break;
-                    }
+        for (int r = 0; r < rows; ++r) {
+            for (int c = 0; c < cols; ++c) {
+                int vertex = r * cols + c + 1;
+                if (c + 1 < cols) {
+                    AddEdge(vertex, vertex + 1, 1 + (std::rand() % 10));
                 }
-
-                if (neighborIndex != -1) {
-                    if (!visited[neighborIndex] && hasCycleUtil(neighborIndex, visited, recStack)) {
-                        return true;
-                    } else if (recStack[neighborIndex]) {
-                        return true;
-                    }
+                if (r + 1 < rows) {
+                    AddEdge(vertex, vertex + cols, 1 + (std::rand() % 10));
                 }
             }
         }
-        recStack[v] = false;
-        return false;
+
+        std::cout << "Grid graph generated with " << rows << "x" << cols << " vertices." << std::endl;
     }
+
 };
 
 
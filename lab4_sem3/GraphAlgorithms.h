@@ -0,0 +1,1335 @@
+#ifndef GRAPHALGORITHMS_H
+#define GRAPHALGORITHMS_H
+
+#include "DynamicArray.h"
+#include "GraphParts.h"
+#include "Path.h"
+#include "VertexIndex.h"
+#include "ShortestPathTree.h"
+#include "TopologicalOrder.h"
+#include "DijkstraWorkspace.h"
+#include "ArrayView.h"
+#include "ThreadPool.h"
+#include "DistanceMatrix.h"
+#include <iostream>
+#include <queue>
+#include <set>
+#include <vector>
+#include <functional>
+#include <algorithm>
+#include <climits>
+#include <utility>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+
+// Algorithms shared by Graph<T> and CsrGraph<T>. G has to provide
+//   int GetSize() const, int FindSlot(T) const, T GetVertexName(uint32_t) const, GetIndex() const,
+//   int GetMinWeight() const, int GetMaxWeight() const (bounds on the edge weights)
+// and OutEdges(uint32_t) const / InEdges(uint32_t) const returning ranges of Edge-like values
+// (GetTarget(), GetWeight()); for InEdges the target is the source of the arc.
+
+enum class DijkstraQueue
+{
+    Auto,
+    BinaryHeap,
+    Buckets
+};
+
+// Auto picks the bucket queue when every weight is in [0, DialMaxWeight].
+constexpr int DialMaxWeight = 255;
+// Largest weight an explicit bucket queue accepts; it allocates one bucket per weight value.
+constexpr int DialWeightLimit = 1 << 16;
+
+inline void PushHeap(std::vector<HeapEntry> &heap, HeapEntry entry)
+{
+    heap.push_back(entry);
+    std::push_heap(heap.begin(), heap.end(), std::greater<HeapEntry>());
+}
+
+inline HeapEntry PopHeap(std::vector<HeapEntry> &heap)
+{
+    std::pop_heap(heap.begin(), heap.end(), std::greater<HeapEntry>());
+    HeapEntry top = heap.back();
+    heap.pop_back();
+    return top;
+}
+
+// Stop conditions for the kernels, called once per settled slot.
+struct StopAtVertex
+{
+    int vertex; // -1 settles everything reachable
+
+    bool operator()(int slot) const
+    {
+        return slot == vertex;
+    }
+};
+
+// Stops once every slot of a sorted, duplicate-free list has been settled.
+class StopAtTargets
+{
+private:
+    const std::vector<int> &targets;
+    std::vector<bool> settled;
+    size_t remaining;
+
+public:
+    explicit StopAtTargets(const std::vector<int> &targets_) : targets(targets_), settled(targets_.size(), false), remaining(targets_.size()) {}
+
+    bool operator()(int slot)
+    {
+        auto it = std::lower_bound(targets.begin(), targets.end(), slot);
+        if (it != targets.end() && *it == slot && !settled[it - targets.begin()]) {
+            settled[it - targets.begin()] = true;
+            --remaining;
+        }
+        return remaining == 0;
+    }
+};
+
+// StopAtTargets for a target set shared by many searches over the whole graph: targetIds[slot] numbers the
+// targets 0 .. count - 1 and is -1 for every other slot, so the check per settled vertex is one lookup.
+class StopAtIndexedTargets
+{
+private:
+    const std::vector<int> &targetIds;
+    std::vector<bool> settled;
+    size_t remaining;
+
+public:
+    StopAtIndexedTargets(const std::vector<int> &targetIds_, size_t count) : targetIds(targetIds_), settled(count, false), remaining(count) {}
+
+    bool operator()(int slot)
+    {
+        int id = targetIds[slot];
+        if (id != -1 && !settled[id]) {
+            settled[id] = true;
+            --remaining;
+        }
+        return remaining == 0;
+    }
+};
+
+// Stops at the first settled slot farther than radius, so everything within radius is settled.
+struct StopBeyondDistance
+{
+    const DijkstraWorkspace &workspace;
+    int radius;
+
+    bool operator()(int slot) const
+    {
+        return workspace.GetDistance(slot) > radius;
+    }
+};
+
+// Searches the reverse of g: OutEdges are the arcs that enter a vertex.
+template<typename G>
+class ReverseGraph
+{
+private:
+    const G &g;
+
+public:
+    explicit ReverseGraph(const G &g_) : g(g_) {}
+
+    int GetSize() const
+    {
+        return g.GetSize();
+    }
+
+    int GetMinWeight() const
+    {
+        return g.GetMinWeight();
+    }
+
+    int GetMaxWeight() const
+    {
+        return g.GetMaxWeight();
+    }
+
+    EdgeRange OutEdges(uint32_t slot) const
+    {
+        return g.InEdges(slot);
+    }
+};
+
+// The kernels below label the workspace they are given (after resetting it) and stop once stop(slot)
+// returns true for a settled slot. Labels of vertices that were not settled by then are upper bounds.
+template<typename G, typename Stop>
+void DijkstraHeap(const G &g, int startVertexIndex, DijkstraWorkspace &workspace, Stop &&stop)
+{
+    workspace.Reset(g.GetSize());
+    workspace.Label(startVertexIndex, 0, -1);
+
+    // Lazy deletion: an entry is stale when its key no longer matches the label.
+    std::vector<HeapEntry> &heap = workspace.heap;
+    PushHeap(heap, HeapEntry{0, 0, startVertexIndex});
+
+    while (!heap.empty()) {
+        HeapEntry top = PopHeap(heap);
+        int d = top.key;
+        int u = top.slot;
+        if (d != workspace.GetDistance(u)) {
+            continue;
+        }
+        if (stop(u)) {
+            break;
+        }
+
+        for (const auto &edge : g.OutEdges(u)) {
+            int vertEnd = static_cast<int>(edge.GetTarget());
+            int newDist = d + edge.GetWeight();
+            if (workspace.GetDistance(vertEnd) > newDist) {
+                workspace.Label(vertEnd, newDist, u);
+                PushHeap(heap, HeapEntry{newDist, newDist, vertEnd});
+            }
+        }
+    }
+}
+
+// Dial's algorithm: maxWeight + 1 buckets used as a circular queue indexed by distance, which is enough
+// because every tentative distance lies in [current, current + maxWeight]. Requires non-negative weights.
+template<typename G, typename Stop>
+void DijkstraDial(const G &g, int startVertexIndex, int maxWeight, DijkstraWorkspace &workspace, Stop &&stop)
+{
+    workspace.Reset(g.GetSize());
+    size_t numBuckets = static_cast<size_t>(maxWeight) + 1;
+    std::vector<std::vector<int>> &buckets = workspace.buckets;
+    if (buckets.size() < numBuckets) {
+        buckets.resize(numBuckets);
+    }
+    for (size_t i = 0; i < numBuckets; ++i) {
+        buckets[i].clear();
+    }
+    workspace.Label(startVertexIndex, 0, -1);
+    buckets[0].push_back(startVertexIndex);
+    size_t queued = 1;
+
+    for (int d = 0; queued > 0; ++d) {
+        std::vector<int> &bucket = buckets[d % numBuckets];
+        // Zero-weight edges append to the bucket being scanned, so iterate by index.
+        for (size_t i = 0; i < bucket.size(); ++i) {
+            int u = bucket[i];
+            --queued;
+            if (workspace.GetDistance(u) != d) {
+                continue;
+            }
+            if (stop(u)) {
+                return;
+            }
+
+            for (const auto &edge : g.OutEdges(u)) {
+                int vertEnd = static_cast<int>(edge.GetTarget());
+                int newDist = d + edge.GetWeight();
+                if (workspace.GetDistance(vertEnd) > newDist) {
+                    workspace.Label(vertEnd, newDist, u);
+                    buckets[newDist % numBuckets].push_back(vertEnd);
+                    ++queued;
+                }
+            }
+        }
+        bucket.clear();
+    }
+}
+
+// Runs the kernel selected by queue.
+template<typename G, typename Stop>
+bool DijkstraIds(const G &g, int startVertexIndex, DijkstraQueue queue, DijkstraWorkspace &workspace, Stop &&stop)
+{
+    if (queue == DijkstraQueue::Auto) {
+        bool smallWeights = g.GetMinWeight() >= 0 && g.GetMaxWeight() <= DialMaxWeight;
+        queue = smallWeights ? DijkstraQueue::Buckets : DijkstraQueue::BinaryHeap;
+    }
+    if (queue == DijkstraQueue::Buckets && g.GetMinWeight() < 0) {
+        std::cout << "Dial's algorithm requires non-negative weights." << std::endl;
+        return false;
+    }
+    if (queue == DijkstraQueue::Buckets && g.GetMaxWeight() > DialWeightLimit) {
+        std::cout << "Dial's algorithm requires weights up to " << DialWeightLimit << "." << std::endl;
+        return false;
+    }
+
+    if (queue == DijkstraQueue::Buckets) {
+        DijkstraDial(g, startVertexIndex, g.GetMaxWeight(), workspace, stop);
+    } else {
+        DijkstraHeap(g, startVertexIndex, workspace, stop);
+    }
+    return true;
+}
+
+// Prints the same messages as Graph::Dijkstra always did when the query cannot run.
+template<typename G, typename T>
+bool ResolveEndpoints(const G &g, T startVertexName, T endVertexName, int &startVertexIndex, int &endVertexIndex)
+{
+    if (g.GetSize() == 0) {
+        std::cout << "Graph is empty." << std::endl;
+        return false;
+    }
+    startVertexIndex = g.FindSlot(startVertexName);
+    endVertexIndex = g.FindSlot(endVertexName);
+    if (startVertexIndex == -1 || endVertexIndex == -1) {
+        std::cout << "Start or end vertex not found." << std::endl;
+        return false;
+    }
+    return true;
+}
+
+// Vertex names from the start of the search to endVertexIndex, which must have been reached.
+template<typename T, typename G>
+DynamicArray<T> CollectPath(const G &g, int endVertexIndex, const DijkstraWorkspace &workspace)
+{
+    DynamicArray<T> path;
+    for (int at = endVertexIndex; at != -1; at = workspace.GetPrevious(at)) {
+        path.push_back(g.GetVertexName(at));
+    }
+    std::reverse(path.begin(), path.end());
+    return path;
+}
+
+// The message every point-to-point query prints; false when there is no path.
+template<typename T>
+bool ReportDistance(T startVertexName, T endVertexName, int distance)
+{
+    if (distance == INT_MAX) {
+        std::cout << "Path from " << startVertexName << " to " << endVertexName << " does not exist." << std::endl;
+        return false;
+    }
+    std::cout << "Shortest distance from " << startVertexName << " to " << endVertexName << " is: " << distance << std::endl;
+    return true;
+}
+
+// Reports the distance and walks the predecessors back from the end vertex. The full distance array
+// costs O(V), so callers that pass their own workspace skip it and read distances from the workspace.
+template<typename G, typename T>
+Path<T> FinishPath(const G &g, T startVertexName, T endVertexName, int endVertexIndex, const DijkstraWorkspace &workspace, bool exportDistances = true)
+{
+    if (!ReportDistance(startVertexName, endVertexName, workspace.GetDistance(endVertexIndex))) {
+        return Path<T>();
+    }
+
+    DynamicArray<int> dist = exportDistances ? workspace.ExportDistances(g.GetSize()) : DynamicArray<int>(0);
+    return Path<T>(std::move(dist), CollectPath<T>(g, endVertexIndex, workspace), workspace.GetDistance(endVertexIndex));
+}
+
+template<typename G, typename T>
+Path<T> DijkstraSearch(const G &g, T startVertexName, T endVertexName, DijkstraQueue queue = DijkstraQueue::Auto)
+{
+    int startVertexIndex, endVertexIndex;
+    if (!ResolveEndpoints(g, startVertexName, endVertexName, startVertexIndex, endVertexIndex)) {
+        return Path<T>();
+    }
+    DijkstraWorkspace &workspace = ThreadWorkspace();
+    if (!DijkstraIds(g, startVertexIndex, queue, workspace, StopAtVertex{endVertexIndex})) {
+        return Path<T>();
+    }
+
+    return FinishPath(g, startVertexName, endVertexName, endVertexIndex, workspace);
+}
+
+// The returned Path holds only the vertices; distances stay in the workspace until its next search.
+template<typename G, typename T>
+Path<T> DijkstraSearch(const G &g, T startVertexName, T endVertexName, DijkstraWorkspace &workspace)
+{
+    int startVertexIndex, endVertexIndex;
+    if (!ResolveEndpoints(g, startVertexName, endVertexName, startVertexIndex, endVertexIndex)) {
+        return Path<T>();
+    }
+    if (!DijkstraIds(g, startVertexIndex, DijkstraQueue::Auto, workspace, StopAtVertex{endVertexIndex})) {
+        return Path<T>();
+    }
+
+    return FinishPath(g, startVertexName, endVertexName, endVertexIndex, workspace, false);
+}
+
+// One full search from the source; paths to any number of targets are then read off the tree.
+template<typename G, typename T>
+ShortestPathTree<T> ShortestPathTreeSearch(const G &g, T sourceVertexName)
+{
+    if (g.GetSize() == 0) {
+        std::cout << "Graph is empty." << std::endl;
+        return ShortestPathTree<T>();
+    }
+    int sourceVertexIndex = g.FindSlot(sourceVertexName);
+    if (sourceVertexIndex == -1) {
+        std::cout << "Start vertex not found." << std::endl;
+        return ShortestPathTree<T>();
+    }
+
+    DijkstraWorkspace &workspace = ThreadWorkspace();
+    if (!DijkstraIds(g, sourceVertexIndex, DijkstraQueue::Auto, workspace, StopAtVertex{-1})) {
+        return ShortestPathTree<T>();
+    }
+    return ShortestPathTree<T>(g.GetIndex(), sourceVertexIndex, workspace.ExportDistances(g.GetSize()), workspace.ExportPredecessors(g.GetSize()));
+}
+
+// Every vertex at distance at most radius from the source, with its distance, nearest first. The search
+// stops at the first vertex beyond radius and only the vertices it labelled are scanned, so the cost follows
+// the size of the ball and its boundary (the reused workspace resets in constant time). Requires
+// non-negative weights.
+template<typename G, typename T>
+DynamicArray<std::pair<T, int>> WithinDistanceSearch(const G &g, T sourceVertexName, int radius)
+{
+    DynamicArray<std::pair<T, int>> result;
+    if (g.GetSize() == 0) {
+        std::cout << "Graph is empty." << std::endl;
+        return result;
+    }
+    int sourceVertexIndex = g.FindSlot(sourceVertexName);
+    if (sourceVertexIndex == -1) {
+        std::cout << "Start vertex not found." << std::endl;
+        return result;
+    }
+    if (g.GetMinWeight() < 0) {
+        std::cout << "Bounded search requires non-negative weights." << std::endl;
+        return result;
+    }
+
+    DijkstraWorkspace &workspace = ThreadWorkspace();
+    DijkstraIds(g, sourceVertexIndex, DijkstraQueue::Auto, workspace, StopBeyondDistance{workspace, radius});
+    // (distance, slot) of the ball; tentative labels beyond radius are left out.
+    std::vector<std::pair<int, int>> ball;
+    for (int slot : workspace.GetTouched()) {
+        if (workspace.GetDistance(slot) <= radius) {
+            ball.push_back(std::make_pair(workspace.GetDistance(slot), slot));
+        }
+    }
+    std::sort(ball.begin(), ball.end());
+    for (const auto &entry : ball) {
+        result.push_back(std::make_pair(g.GetVertexName(entry.second), entry.first));
+    }
+    return result;
+}
+
+// Answers every (start, end) query without printing; result i belongs to queries[i]. Queries are grouped by
+// start vertex, each group is one search that stops once all of its ends are settled, and the groups run in
+// parallel on the pool, every thread in its own ThreadWorkspace. The Paths carry no distance array; an unknown
+// or unreachable vertex gives an empty Path. The graph must not change until the batch returns.
+template<typename G, typename T>
+DynamicArray<Path<T>> DijkstraBatchSearch(const G &g, ArrayView<std::pair<T, T>> queries, ThreadPool &pool)
+{
+    size_t numQueries = queries.get_size();
+    DynamicArray<Path<T>> results(numQueries);
+    std::vector<int> ends(numQueries, -1);
+    // (start slot, query number), sorted so that every group is a contiguous run.
+    std::vector<std::pair<int, size_t>> order;
+    order.reserve(numQueries);
+    for (size_t i = 0; i < numQueries; i++) {
+        int startVertexIndex = g.FindSlot(queries[i].first);
+        ends[i] = g.FindSlot(queries[i].second);
+        if (startVertexIndex != -1 && ends[i] != -1) {
+            order.emplace_back(startVertexIndex, i);
+        }
+    }
+    std::sort(order.begin(), order.end());
+    std::vector<size_t> groupBegin;
+    for (size_t k = 0; k < order.size(); k++) {
+        if (k == 0 || order[k].first != order[k - 1].first) {
+            groupBegin.push_back(k);
+        }
+    }
+    groupBegin.push_back(order.size());
+
+    pool.ParallelFor(groupBegin.size() - 1, [&](size_t group) {
+        size_t first = groupBegin[group];
+        size_t last = groupBegin[group + 1];
+        std::vector<int> targets;
+        for (size_t k = first; k < last; k++) {
+            targets.push_back(ends[order[k].second]);
+        }
+        std::sort(targets.begin(), targets.end());
+        targets.erase(std::unique(targets.begin(), targets.end()), targets.end());
+
+        DijkstraWorkspace &workspace = ThreadWorkspace();
+        DijkstraIds(g, order[first].first, DijkstraQueue::Auto, workspace, StopAtTargets(targets));
+        for (size_t k = first; k < last; k++) {
+            size_t i = order[k].second;
+            if (workspace.IsReached(ends[i])) {
+                results[i] = Path<T>(DynamicArray<int>(0), CollectPath<T>(g, ends[i], workspace), workspace.GetDistance(ends[i]));
+            }
+        }
+    });
+    return results;
+}
+
+// Distances from every source to every target without printing: entry (i, j) is the distance from
+// sources[i] to targets[j], INT_MAX when either is unknown or there is no path. One search per distinct
+// source, stopped once all targets are settled; the sources run in parallel on the pool.
+template<typename G, typename T>
+DistanceMatrix DistanceTableSearch(const G &g, ArrayView<T> sources, ArrayView<T> targets, ThreadPool &pool)
+{
+    DistanceMatrix result(sources.get_size(), targets.get_size());
+    std::vector<int> targetIds(g.GetSize(), -1);
+    size_t numTargets = 0;
+    std::vector<int> columns(targets.get_size());
+    for (size_t j = 0; j < targets.get_size(); j++) {
+        columns[j] = g.FindSlot(targets[j]);
+        if (columns[j] != -1 && targetIds[columns[j]] == -1) {
+            targetIds[columns[j]] = static_cast<int>(numTargets++);
+        }
+    }
+    // A repeated source copies the row of its first occurrence.
+    std::vector<int> rows(sources.get_size());
+    std::vector<size_t> firstRow;
+    std::vector<std::pair<int, size_t>> order;
+    for (size_t i = 0; i < sources.get_size(); i++) {
+        rows[i] = g.FindSlot(sources[i]);
+        if (rows[i] != -1) {
+            order.emplace_back(rows[i], i);
+        }
+    }
+    std::sort(order.begin(), order.end());
+    for (size_t k = 0; k < order.size(); k++) {
+        if (k == 0 || order[k].first != order[k - 1].first) {
+            firstRow.push_back(order[k].second);
+        }
+    }
+
+    pool.ParallelFor(firstRow.size(), [&](size_t task) {
+        size_t i = firstRow[task];
+        DijkstraWorkspace &workspace = ThreadWorkspace();
+        DijkstraIds(g, rows[i], DijkstraQueue::Auto, workspace, StopAtIndexedTargets(targetIds, numTargets));
+        int *row = result.Row(i);
+        for (size_t j = 0; j < columns.size(); j++) {
+            if (columns[j] != -1) {
+                row[j] = workspace.GetDistance(columns[j]);
+            }
+        }
+    });
+    for (size_t k = 1; k < order.size(); k++) {
+        if (order[k].first == order[k - 1].first) {
+            std::copy(result.Row(order[k - 1].second), result.Row(order[k - 1].second) + columns.size(), result.Row(order[k].second));
+        }
+    }
+    return result;
+}
+
+// Delta-stepping: bucket b holds the vertices with tentative distance in [b * delta, (b + 1) * delta).
+// A bucket is drained by relaxing the light arcs (weight <= delta) of its vertices until no vertex falls
+// back into it, then the heavy arcs of everything it settled are relaxed once. Each relaxation round is
+// split into chunks that run on the pool; a label packs distance and predecessor into one 64-bit atomic,
+// lowered with compare-and-swap, so both always belong to the same relaxation. Only the buckets that can
+// still hold a tentative distance are kept (a circular array of maxWeight / delta + 2, delta being raised
+// if needed to keep it within DeltaSteppingBucketLimit), and a min-heap of the numbers of the non-empty
+// ones skips the empty ones in between. Stops once endVertexIndex is settled (-1 settles everything) and
+// copies the labels into the workspace.
+// Requires non-negative weights; delta <= 0 picks maxWeight / average out-degree.
+constexpr int DeltaSteppingBucketLimit = 1 << 16;
+
+template<typename G>
+bool DeltaSteppingIds(const G &g, int startVertexIndex, int endVertexIndex, int delta, ThreadPool &pool, DijkstraWorkspace &workspace)
+{
+    if (g.GetMinWeight() < 0) {
+        std::cout << "Delta-stepping requires non-negative weights." << std::endl;
+        return false;
+    }
+    size_t numVertices = static_cast<size_t>(g.GetSize());
+    if (delta <= 0) {
+        size_t numArcs = 0;
+        for (size_t u = 0; u < numVertices; u++) {
+            numArcs += g.OutEdges(static_cast<uint32_t>(u)).size();
+        }
+        size_t averageDegree = std::max<size_t>(1, numArcs / std::max<size_t>(1, numVertices));
+        delta = std::max(1, static_cast<int>(g.GetMaxWeight() / averageDegree));
+    }
+    delta = std::max(delta, g.GetMaxWeight() / DeltaSteppingBucketLimit + 1);
+
+    const uint64_t unreached = ~uint64_t(0);
+    auto pack = [](int distance, int previous) { return (uint64_t(uint32_t(distance)) << 32) | uint32_t(previous); };
+    auto distanceOf = [](uint64_t label) { return label == ~uint64_t(0) ? INT_MAX : int(label >> 32); };
+    std::vector<std::atomic<uint64_t>> labels(numVertices);
+    for (auto &label : labels) {
+        label.store(unreached, std::memory_order_relaxed);
+    }
+    auto distance = [&](int slot) { return distanceOf(labels[slot].load(std::memory_order_relaxed)); };
+
+    size_t numBuckets = static_cast<size_t>(g.GetMaxWeight() / delta) + 2;
+    std::vector<std::vector<int>> buckets(numBuckets);
+    std::vector<size_t> nonEmpty;
+    size_t queued = 0;
+    auto enqueue = [&](int slot) {
+        size_t number = static_cast<size_t>(distance(slot) / delta);
+        std::vector<int> &bucket = buckets[number % numBuckets];
+        if (bucket.empty()) {
+            nonEmpty.push_back(number);
+            std::push_heap(nonEmpty.begin(), nonEmpty.end(), std::greater<size_t>());
+        }
+        bucket.push_back(slot);
+        ++queued;
+    };
+    labels[startVertexIndex].store(pack(0, -1), std::memory_order_relaxed);
+    enqueue(startVertexIndex);
+
+    // Relaxes the light or the heavy arcs of every vertex in from; lowered vertices are bucketed afterwards.
+    const size_t grain = 256;
+    std::vector<std::vector<int>> lowered;
+    auto relax = [&](const std::vector<int> &from, bool light) {
+        size_t numChunks = (from.size() + grain - 1) / grain;
+        if (lowered.size() < numChunks) {
+            lowered.resize(numChunks);
+        }
+        pool.ParallelFor(numChunks, [&](size_t chunk) {
+            std::vector<int> &mine = lowered[chunk];
+            mine.clear();
+            size_t last = std::min(from.size(), (chunk + 1) * grain);
+            for (size_t k = chunk * grain; k < last; k++) {
+                int u = from[k];
+                int d = distance(u);
+                for (const auto &edge : g.OutEdges(static_cast<uint32_t>(u))) {
+                    if ((edge.GetWeight() <= delta) != light) {
+                        continue;
+                    }
+                    int v = static_cast<int>(edge.GetTarget());
+                    int newDist = d + edge.GetWeight();
+                    uint64_t old = labels[v].load(std::memory_order_relaxed);
+                    while (distanceOf(old) > newDist) {
+                        if (labels[v].compare_exchange_weak(old, pack(newDist, u), std::memory_order_relaxed)) {
+                            mine.push_back(v);
+                            break;
+                        }
+                    }
+                }
+            }
+        });
+        for (size_t chunk = 0; chunk < numChunks; chunk++) {
+            for (int v : lowered[chunk]) {
+                enqueue(v);
+            }
+        }
+    };
+
+    // A vertex can sit in a bucket several times; the stamps keep it once per round and once per bucket.
+    std::vector<uint32_t> roundStamp(numVertices, 0);
+    std::vector<uint32_t> bucketStamp(numVertices, 0);
+    uint32_t round = 0;
+    std::vector<int> frontier;
+    std::vector<int> settled;
+    while (queued > 0) {
+        // A number can be listed twice when its bucket emptied and filled again; the second one finds it empty.
+        std::pop_heap(nonEmpty.begin(), nonEmpty.end(), std::greater<size_t>());
+        size_t b = nonEmpty.back();
+        nonEmpty.pop_back();
+        std::vector<int> &bucket = buckets[b % numBuckets];
+        if (bucket.empty()) {
+            continue;
+        }
+        settled.clear();
+        uint32_t bucketRound = round + 1;
+        while (!bucket.empty()) {
+            ++round;
+            frontier.clear();
+            for (int u : bucket) {
+                if (static_cast<size_t>(distance(u) / delta) != b || roundStamp[u] == round) {
+                    continue;
+                }
+                roundStamp[u] = round;
+                frontier.push_back(u);
+                if (bucketStamp[u] != bucketRound) {
+                    bucketStamp[u] = bucketRound;
+                    settled.push_back(u);
+                }
+            }
+            queued -= bucket.size();
+            bucket.clear();
+            relax(frontier, true);
+        }
+        relax(settled, false);
+        if (endVertexIndex != -1 && distance(endVertexIndex) != INT_MAX && static_cast<size_t>(distance(endVertexIndex) / delta) <= b) {
+            break;
+        }
+    }
+
+    workspace.Reset(g.GetSize());
+    for (size_t v = 0; v < numVertices; v++) {
+        uint64_t label = labels[v].load(std::memory_order_relaxed);
+        if (label != unreached) {
+            workspace.Label(static_cast<int>(v), distanceOf(label), static_cast<int>(int32_t(uint32_t(label))));
+        }
+    }
+    return true;
+}
+
+template<typename G, typename T>
+Path<T> DeltaSteppingSearch(const G &g, T startVertexName, T endVertexName, int delta, ThreadPool &pool)
+{
+    int startVertexIndex, endVertexIndex;
+    if (!ResolveEndpoints(g, startVertexName, endVertexName, startVertexIndex, endVertexIndex)) {
+        return Path<T>();
+    }
+    DijkstraWorkspace &workspace = ThreadWorkspace();
+    if (!DeltaSteppingIds(g, startVertexIndex, endVertexIndex, delta, pool, workspace)) {
+        return Path<T>();
+    }
+
+    return FinishPath(g, startVertexName, endVertexName, endVertexIndex, workspace);
+}
+
+// Floyd-Warshall works on a matrix that uses FloydInfinity for "no path yet", so that the sum of two
+// entries cannot overflow; entries are tiled FloydTile x FloydTile (three tiles fit in L1/L2).
+constexpr int FloydInfinity = INT_MAX / 2;
+constexpr size_t FloydTile = 64;
+
+// rowI[j] = min(rowI[j], throughK + rowK[j]). The rows never overlap and full tiles have a compile-time
+// width, so the compiler turns the loop into SIMD min/add without alias checks or a scalar tail.
+template<size_t Width>
+inline void MinPlusRow(int *__restrict rowI, const int *__restrict rowK, int throughK)
+{
+    for (size_t j = 0; j < Width; j++) {
+        int candidate = throughK + rowK[j];
+        rowI[j] = candidate < rowI[j] ? candidate : rowI[j];
+    }
+}
+
+inline void MinPlusRow(int *__restrict rowI, const int *__restrict rowK, int throughK, size_t width)
+{
+    for (size_t j = 0; j < width; j++) {
+        int candidate = throughK + rowK[j];
+        rowI[j] = candidate < rowI[j] ? candidate : rowI[j];
+    }
+}
+
+// matrix[i][j] = min(matrix[i][j], matrix[i][k] + matrix[k][j]) for the rows, columns and ks of one tile.
+// Row k itself is skipped: without negative cycles matrix[k][k] is 0 and cannot improve it.
+inline void MinPlusTile(int *matrix, size_t stride, size_t rowBegin, size_t rowEnd, size_t colBegin, size_t colEnd, size_t kBegin, size_t kEnd)
+{
+    size_t width = colEnd - colBegin;
+    for (size_t k = kBegin; k < kEnd; k++) {
+        const int *rowK = matrix + k * stride + colBegin;
+        for (size_t i = rowBegin; i < rowEnd; i++) {
+            int *rowI = matrix + i * stride;
+            int throughK = rowI[k];
+            if (i == k || throughK >= FloydInfinity) {
+                continue;
+            }
+            if (width == FloydTile) {
+                MinPlusRow<FloydTile>(rowI + colBegin, rowK, throughK);
+            } else {
+                MinPlusRow(rowI + colBegin, rowK, throughK, width);
+            }
+        }
+    }
+}
+
+// Blocked Floyd-Warshall: for every diagonal tile kb, first the tile itself, then (in parallel) the other
+// tiles of its row and column, then (in parallel) all remaining tiles, which only read finished ones.
+// Row and column i belong to slot i. Negative weights are allowed as long as there is no negative cycle
+// and path lengths stay well below FloydInfinity / 2 in absolute value.
+template<typename G>
+DistanceMatrix AllPairsSearch(const G &g, ThreadPool &pool)
+{
+    size_t numVertices = static_cast<size_t>(g.GetSize());
+    DistanceMatrix result(numVertices, numVertices, FloydInfinity);
+    int *matrix = result.GetData();
+    for (size_t u = 0; u < numVertices; u++) {
+        int *row = result.Row(u);
+        row[u] = 0;
+        for (const auto &edge : g.OutEdges(static_cast<uint32_t>(u))) {
+            row[edge.GetTarget()] = std::min(row[edge.GetTarget()], edge.GetWeight());
+        }
+    }
+
+    size_t numTiles = (numVertices + FloydTile - 1) / FloydTile;
+    auto tileBegin = [&](size_t tile) { return tile * FloydTile; };
+    auto tileEnd = [&](size_t tile) { return std::min(numVertices, (tile + 1) * FloydTile); };
+    auto relaxTile = [&](size_t rowTile, size_t colTile, size_t kTile) {
+        MinPlusTile(matrix, numVertices, tileBegin(rowTile), tileEnd(rowTile), tileBegin(colTile), tileEnd(colTile), tileBegin(kTile), tileEnd(kTile));
+    };
+
+    for (size_t kb = 0; kb < numTiles; kb++) {
+        relaxTile(kb, kb, kb);
+        pool.ParallelFor(2 * (numTiles - 1), [&](size_t task) {
+            size_t other = task / 2 < kb ? task / 2 : task / 2 + 1;
+            if (task % 2 == 0) {
+                relaxTile(kb, other, kb);
+            } else {
+                relaxTile(other, kb, kb);
+            }
+        });
+        pool.ParallelFor((numTiles - 1) * (numTiles - 1), [&](size_t task) {
+            size_t rowTile = task / (numTiles - 1);
+            size_t colTile = task % (numTiles - 1);
+            relaxTile(rowTile < kb ? rowTile : rowTile + 1, colTile < kb ? colTile : colTile + 1, kb);
+        });
+    }
+
+    for (size_t i = 0; i < numVertices * numVertices; i++) {
+        if (matrix[i] > FloydInfinity / 2) {
+            matrix[i] = INT_MAX;
+        }
+    }
+    return result;
+}
+
+// Forward search from the start over OutEdges and backward search from the end over InEdges, always
+// advancing the side with the smaller queue key. Every arc relaxed towards a vertex the other side has
+// reached closes a candidate path; the search stops once the two queue keys sum to at least the best one.
+// The backward half of the best path is then spliced onto the forward labels.
+template<typename G>
+void BidirectionalDijkstraIds(const G &g, int startVertexIndex, int endVertexIndex, DijkstraWorkspace &forward, DijkstraWorkspace &backward)
+{
+    forward.Reset(g.GetSize());
+    backward.Reset(g.GetSize());
+    forward.Label(startVertexIndex, 0, -1);
+    backward.Label(endVertexIndex, 0, -1);
+    PushHeap(forward.heap, HeapEntry{0, 0, startVertexIndex});
+    PushHeap(backward.heap, HeapEntry{0, 0, endVertexIndex});
+    int best = startVertexIndex == endVertexIndex ? 0 : INT_MAX;
+    int meet = startVertexIndex == endVertexIndex ? startVertexIndex : -1;
+
+    while (!forward.heap.empty() && !backward.heap.empty()) {
+        if (best != INT_MAX && forward.heap.front().key + backward.heap.front().key >= best) {
+            break;
+        }
+        bool forwardSide = forward.heap.front().key <= backward.heap.front().key;
+        DijkstraWorkspace &own = forwardSide ? forward : backward;
+        DijkstraWorkspace &other = forwardSide ? backward : forward;
+
+        HeapEntry top = PopHeap(own.heap);
+        int d = top.key;
+        int u = top.slot;
+        if (d != own.GetDistance(u)) {
+            continue;
+        }
+
+        auto relax = [&](const auto &edges) {
+            for (const auto &edge : edges) {
+                int v = static_cast<int>(edge.GetTarget());
+                int newDist = d + edge.GetWeight();
+                if (own.GetDistance(v) > newDist) {
+                    own.Label(v, newDist, u);
+                    PushHeap(own.heap, HeapEntry{newDist, newDist, v});
+                }
+                if (other.IsReached(v) && own.GetDistance(v) + other.GetDistance(v) < best) {
+                    best = own.GetDistance(v) + other.GetDistance(v);
+                    meet = v;
+                }
+            }
+        };
+        if (forwardSide) {
+            relax(g.OutEdges(u));
+        } else {
+            relax(g.InEdges(u));
+        }
+    }
+
+    if (meet == -1) {
+        return;
+    }
+    // The backward predecessor of a vertex is its successor on the path to the end vertex. With zero-weight
+    // cycles the two halves can share vertices; joining at the last shared one keeps the labels a tree.
+    std::vector<int> forwardChain;
+    for (int at = meet; at != -1; at = forward.GetPrevious(at)) {
+        forwardChain.push_back(at);
+    }
+    std::sort(forwardChain.begin(), forwardChain.end());
+    int join = meet;
+    for (int at = meet; at != endVertexIndex;) {
+        at = backward.GetPrevious(at);
+        if (std::binary_search(forwardChain.begin(), forwardChain.end(), at)) {
+            join = at;
+        }
+    }
+    for (int at = join; at != endVertexIndex; at = backward.GetPrevious(at)) {
+        int next = backward.GetPrevious(at);
+        forward.Label(next, forward.GetDistance(at) + (backward.GetDistance(at) - backward.GetDistance(next)), at);
+    }
+}
+
+// A* with reopening, so any admissible heuristic gives a shortest path (a consistent one never reopens).
+// heuristic(slot) must not overestimate the distance from slot to the end vertex.
+template<typename G, typename Heuristic>
+void AStarIds(const G &g, int startVertexIndex, int endVertexIndex, Heuristic &&heuristic, DijkstraWorkspace &workspace)
+{
+    workspace.Reset(g.GetSize());
+    workspace.Label(startVertexIndex, 0, -1);
+    // Keyed by distance + estimate; an entry is stale when its distance no longer matches the label.
+    std::vector<HeapEntry> &heap = workspace.heap;
+    PushHeap(heap, HeapEntry{heuristic(startVertexIndex), 0, startVertexIndex});
+
+    while (!heap.empty()) {
+        HeapEntry top = PopHeap(heap);
+        int d = top.distance;
+        int u = top.slot;
+        if (d != workspace.GetDistance(u)) {
+            continue;
+        }
+        if (u == endVertexIndex) {
+            break;
+        }
+
+        for (const auto &edge : g.OutEdges(u)) {
+            int v = static_cast<int>(edge.GetTarget());
+            int newDist = d + edge.GetWeight();
+            if (workspace.GetDistance(v) > newDist) {
+                workspace.Label(v, newDist, u);
+                PushHeap(heap, HeapEntry{newDist + heuristic(v), newDist, v});
+            }
+        }
+    }
+}
+
+// heuristic is called with a vertex name and returns a lower bound on its distance to endVertexName.
+template<typename G, typename T, typename Heuristic>
+Path<T> AStarSearch(const G &g, T startVertexName, T endVertexName, Heuristic &&heuristic)
+{
+    int startVertexIndex, endVertexIndex;
+    if (!ResolveEndpoints(g, startVertexName, endVertexName, startVertexIndex, endVertexIndex)) {
+        return Path<T>();
+    }
+
+    DijkstraWorkspace &workspace = ThreadWorkspace();
+    const VertexIndex<T> &names = g.GetIndex();
+    AStarIds(g, startVertexIndex, endVertexIndex, [&](int slot) { return heuristic(names.GetName(slot)); }, workspace);
+
+    return FinishPath(g, startVertexName, endVertexName, endVertexIndex, workspace);
+}
+
+template<typename G, typename T>
+Path<T> BidirectionalSearch(const G &g, T startVertexName, T endVertexName)
+{
+    int startVertexIndex, endVertexIndex;
+    if (!ResolveEndpoints(g, startVertexName, endVertexName, startVertexIndex, endVertexIndex)) {
+        return Path<T>();
+    }
+
+    DijkstraWorkspace &forward = ThreadWorkspace(0);
+    BidirectionalDijkstraIds(g, startVertexIndex, endVertexIndex, forward, ThreadWorkspace(1));
+
+    return FinishPath(g, startVertexName, endVertexName, endVertexIndex, forward);
+}
+
+// A* for one spur path of Yen's algorithm. Vertices with blocked[v] set and the arcs from the start to any
+// slot in bannedTargets are skipped, which masks the graph without copying it. toEnd holds the exact
+// distances to the end in the unmasked graph: they stay a consistent lower bound under masking and rule
+// out vertices that cannot reach the end at all. Gives up once no path shorter than limit is left; returns
+// whether the end was settled.
+template<typename G>
+bool SpurSearchIds(const G &g, int startVertexIndex, int endVertexIndex, const std::vector<int> &toEnd, const std::vector<bool> &blocked,
+                   const std::vector<int> &bannedTargets, int limit, DijkstraWorkspace &workspace)
+{
+    workspace.Reset(g.GetSize());
+    if (toEnd[startVertexIndex] == INT_MAX) {
+        return false;
+    }
+    workspace.Label(startVertexIndex, 0, -1);
+    std::vector<HeapEntry> &heap = workspace.heap;
+    PushHeap(heap, HeapEntry{toEnd[startVertexIndex], 0, startVertexIndex});
+
+    while (!heap.empty()) {
+        HeapEntry top = PopHeap(heap);
+        int d = top.distance;
+        int u = top.slot;
+        if (d != workspace.GetDistance(u)) {
+            continue;
+        }
+        if (top.key >= limit) {
+            return false;
+        }
+        if (u == endVertexIndex) {
+            return true;
+        }
+
+        for (const auto &edge : g.OutEdges(u)) {
+            int v = static_cast<int>(edge.GetTarget());
+            if (blocked[v] || toEnd[v] == INT_MAX) {
+                continue;
+            }
+            if (u == startVertexIndex && std::find(bannedTargets.begin(), bannedTargets.end(), v) != bannedTargets.end()) {
+                continue;
+            }
+            int newDist = d + edge.GetWeight();
+            if (workspace.GetDistance(v) > newDist) {
+                workspace.Label(v, newDist, u);
+                PushHeap(heap, HeapEntry{newDist + toEnd[v], newDist, v});
+            }
+        }
+    }
+    return false;
+}
+
+// Yen's k shortest loopless paths, shortest first; fewer when there are not k of them. Paths are vertex
+// sequences, so parallel arcs do not give extra paths. Every spur search runs on the original graph with
+// the root path and the used next arcs masked out (SpurSearchIds), in one reused workspace, and is skipped
+// or cut short once it cannot beat the candidates already good enough to fill the k. Prints only the
+// messages of Dijkstra for unknown vertices; the Paths carry their lengths but no distance array.
+// Requires non-negative weights.
+template<typename G, typename T>
+DynamicArray<Path<T>> KShortestPathsSearch(const G &g, T startVertexName, T endVertexName, int k)
+{
+    DynamicArray<Path<T>> result;
+    int startVertexIndex, endVertexIndex;
+    if (k <= 0 || !ResolveEndpoints(g, startVertexName, endVertexName, startVertexIndex, endVertexIndex)) {
+        return result;
+    }
+    if (g.GetMinWeight() < 0) {
+        std::cout << "K shortest paths require non-negative weights." << std::endl;
+        return result;
+    }
+
+    DijkstraWorkspace &workspace = ThreadWorkspace();
+    DijkstraIds(ReverseGraph<G>(g), endVertexIndex, DijkstraQueue::Auto, workspace, StopAtVertex{-1});
+    std::vector<int> toEnd(g.GetSize());
+    for (int v = 0; v < g.GetSize(); v++) {
+        toEnd[v] = workspace.GetDistance(v);
+    }
+
+    // A path as slots with the distance from the start to each of them.
+    struct Route
+    {
+        std::vector<int> slots;
+        std::vector<int> prefix;
+
+        bool operator<(const Route &other) const
+        {
+            if (prefix.back() != other.prefix.back()) {
+                return prefix.back() < other.prefix.back();
+            }
+            return slots < other.slots;
+        }
+    };
+    std::vector<bool> blocked(g.GetSize(), false);
+    std::vector<int> bannedTargets;
+    // Spur path from the workspace appended to the root slots[0 .. spurIndex] of base.
+    auto extend = [&](const Route &base, size_t spurIndex) {
+        Route route;
+        route.slots.assign(base.slots.begin(), base.slots.begin() + spurIndex);
+        route.prefix.assign(base.prefix.begin(), base.prefix.begin() + spurIndex);
+        size_t rootSize = route.slots.size();
+        int rootLength = spurIndex < base.prefix.size() ? base.prefix[spurIndex] : 0;
+        for (int at = endVertexIndex; at != -1; at = workspace.GetPrevious(at)) {
+            route.slots.push_back(at);
+            route.prefix.push_back(rootLength + workspace.GetDistance(at));
+        }
+        std::reverse(route.slots.begin() + rootSize, route.slots.end());
+        std::reverse(route.prefix.begin() + rootSize, route.prefix.end());
+        return route;
+    };
+
+    std::vector<Route> accepted;
+    std::set<Route> candidates;
+    if (SpurSearchIds(g, startVertexIndex, endVertexIndex, toEnd, blocked, bannedTargets, INT_MAX, workspace)) {
+        candidates.insert(extend(Route(), 0));
+    }
+    while (!candidates.empty()) {
+        accepted.push_back(*candidates.begin());
+        candidates.erase(candidates.begin());
+        size_t needed = static_cast<size_t>(k) - accepted.size();
+        if (needed == 0) {
+            break;
+        }
+        // Only the best needed candidates can still be picked.
+        while (candidates.size() > needed) {
+            candidates.erase(std::prev(candidates.end()));
+        }
+
+        const Route &last = accepted.back();
+        for (size_t spurIndex = 0; spurIndex + 1 < last.slots.size(); spurIndex++) {
+            int spur = last.slots[spurIndex];
+            int rootLength = last.prefix[spurIndex];
+            int limit = candidates.size() == needed ? std::prev(candidates.end())->prefix.back() : INT_MAX;
+            if (toEnd[spur] == INT_MAX || rootLength + toEnd[spur] >= limit) {
+                continue;
+            }
+            bannedTargets.clear();
+            for (const Route &route : accepted) {
+                if (route.slots.size() > spurIndex + 1 && std::equal(last.slots.begin(), last.slots.begin() + spurIndex + 1, route.slots.begin())) {
+                    bannedTargets.push_back(route.slots[spurIndex + 1]);
+                }
+            }
+            for (size_t i = 0; i < spurIndex; i++) {
+                blocked[last.slots[i]] = true;
+            }
+            bool found = SpurSearchIds(g, spur, endVertexIndex, toEnd, blocked, bannedTargets, limit == INT_MAX ? INT_MAX : limit - rootLength, workspace);
+            for (size_t i = 0; i < spurIndex; i++) {
+                blocked[last.slots[i]] = false;
+            }
+            if (found) {
+                candidates.insert(extend(last, spurIndex));
+                if (candidates.size() > needed) {
+                    candidates.erase(std::prev(candidates.end()));
+                }
+            }
+        }
+    }
+
+    for (const Route &route : accepted) {
+        DynamicArray<T> path;
+        for (int slot : route.slots) {
+            path.push_back(g.GetVertexName(slot));
+        }
+        result.push_back(Path<T>(DynamicArray<int>(0), std::move(path), route.prefix.back()));
+    }
+    return result;
+}
+
+// Kahn's algorithm over slots, without recursion: vertices whose remaining in-degree is zero are taken in
+// turn. Returns true with the order of all slots when g is acyclic. Otherwise every vertex left over has an
+// arc from another left-over vertex, so walking such arcs backwards closes a cycle, which is returned in arc
+// order. O(V + E) either way.
+template<typename G>
+bool TopologicalSortIds(const G &g, std::vector<int> &order, std::vector<int> &cycle)
+{
+    int numVertices = g.GetSize();
+    order.clear();
+    cycle.clear();
+    std::vector<int> inDegree(numVertices, 0);
+    for (int u = 0; u < numVertices; u++) {
+        for (const auto &edge : g.OutEdges(static_cast<uint32_t>(u))) {
+            ++inDegree[edge.GetTarget()];
+        }
+    }
+    for (int v = 0; v < numVertices; v++) {
+        if (inDegree[v] == 0) {
+            order.push_back(v);
+        }
+    }
+    for (size_t i = 0; i < order.size(); i++) {
+        for (const auto &edge : g.OutEdges(static_cast<uint32_t>(order[i]))) {
+            if (--inDegree[edge.GetTarget()] == 0) {
+                order.push_back(static_cast<int>(edge.GetTarget()));
+            }
+        }
+    }
+    if (order.size() == static_cast<size_t>(numVertices)) {
+        return true;
+    }
+
+    // walk[i + 1] -> walk[i] is an arc; step[v] is the position of v on the walk.
+    std::vector<int> walk;
+    std::vector<int> step(numVertices, -1);
+    int at = static_cast<int>(std::find_if(inDegree.begin(), inDegree.end(), [](int degree) { return degree > 0; }) - inDegree.begin());
+    while (step[at] == -1) {
+        step[at] = static_cast<int>(walk.size());
+        walk.push_back(at);
+        for (const auto &edge : g.InEdges(static_cast<uint32_t>(at))) {
+            if (inDegree[edge.GetTarget()] > 0) {
+                at = static_cast<int>(edge.GetTarget());
+                break;
+            }
+        }
+    }
+    cycle.assign(walk.rbegin(), walk.rend() - step[at]);
+    order.clear();
+    return false;
+}
+
+template<typename G>
+bool HasCycle(const G &g)
+{
+    std::vector<int> order, cycle;
+    return !TopologicalSortIds(g, order, cycle);
+}
+
+// One pass that gives the order or a cycle to report.
+template<typename T, typename G>
+TopologicalOrder<T> TopologicalOrderSearch(const G &g)
+{
+    std::vector<int> order, cycle;
+    TopologicalSortIds(g, order, cycle);
+    DynamicArray<T> orderNames, cycleNames;
+    for (int slot : order) {
+        orderNames.push_back(g.GetVertexName(slot));
+    }
+    for (int slot : cycle) {
+        cycleNames.push_back(g.GetVertexName(slot));
+    }
+    return TopologicalOrder<T>(std::move(orderNames), std::move(cycleNames));
+}
+
+// Null when g has a cycle.
+template<typename G>
+std::shared_ptr<const DagOrder> ComputeDagOrder(const G &g)
+{
+    auto dag = std::make_shared<DagOrder>();
+    std::vector<int> cycle;
+    if (!TopologicalSortIds(g, dag->order, cycle)) {
+        return nullptr;
+    }
+    dag->position.resize(dag->order.size());
+    for (size_t i = 0; i < dag->order.size(); i++) {
+        dag->position[dag->order[i]] = static_cast<int>(i);
+    }
+    return dag;
+}
+
+// Shortest (or, with longest set, longest) paths from the start in a DAG: the arcs of every reached vertex are
+// relaxed in topological order, so each label is final before it is used. No queue, O(V + E), and any
+// weights. Only the positions from the start up to the end are scanned (all of them when the end is -1),
+// since nothing placed outside that window lies on a path between the two.
+template<typename G>
+void DagPathsIds(const G &g, int startVertexIndex, int endVertexIndex, const DagOrder &dag, bool longest, DijkstraWorkspace &workspace)
+{
+    workspace.Reset(g.GetSize());
+    workspace.Label(startVertexIndex, 0, -1);
+    int last = endVertexIndex == -1 ? static_cast<int>(dag.order.size()) - 1 : dag.position[endVertexIndex];
+    for (int i = dag.position[startVertexIndex]; i <= last; i++) {
+        int u = dag.order[i];
+        if (!workspace.IsReached(u)) {
+            continue;
+        }
+        int d = workspace.GetDistance(u);
+        for (const auto &edge : g.OutEdges(static_cast<uint32_t>(u))) {
+            int v = static_cast<int>(edge.GetTarget());
+            int newDist = d + edge.GetWeight();
+            if (dag.position[v] > last) {
+                continue;
+            }
+            if (!workspace.IsReached(v) || (longest ? newDist > workspace.GetDistance(v) : newDist < workspace.GetDistance(v))) {
+                workspace.Label(v, newDist, u);
+            }
+        }
+    }
+}
+
+// Same output as DijkstraSearch, computed with DagPathsIds.
+template<typename G, typename T>
+Path<T> DagPathSearch(const G &g, T startVertexName, T endVertexName, const DagOrder &dag)
+{
+    int startVertexIndex, endVertexIndex;
+    if (!ResolveEndpoints(g, startVertexName, endVertexName, startVertexIndex, endVertexIndex)) {
+        return Path<T>();
+    }
+    DijkstraWorkspace &workspace = ThreadWorkspace();
+    DagPathsIds(g, startVertexIndex, endVertexIndex, dag, false, workspace);
+    return FinishPath(g, startVertexName, endVertexName, endVertexIndex, workspace);
+}
+
+// Same output as DijkstraSearch with a caller's workspace.
+template<typename G, typename T>
+Path<T> DagPathSearch(const G &g, T startVertexName, T endVertexName, const DagOrder &dag, DijkstraWorkspace &workspace)
+{
+    int startVertexIndex, endVertexIndex;
+    if (!ResolveEndpoints(g, startVertexName, endVertexName, startVertexIndex, endVertexIndex)) {
+        return Path<T>();
+    }
+    DagPathsIds(g, startVertexIndex, endVertexIndex, dag, false, workspace);
+    return FinishPath(g, startVertexName, endVertexName, endVertexIndex, workspace, false);
+}
+
+// Shortest or longest paths from the source to every vertex; dag is null when the graph has a cycle.
+template<typename G, typename T>
+ShortestPathTree<T> DagPathTreeSearch(const G &g, T sourceVertexName, const DagOrder *dag, bool longest)
+{
+    if (g.GetSize() == 0) {
+        std::cout << "Graph is empty." << std::endl;
+        return ShortestPathTree<T>();
+    }
+    int sourceVertexIndex = g.FindSlot(sourceVertexName);
+    if (sourceVertexIndex == -1) {
+        std::cout << "Start vertex not found." << std::endl;
+        return ShortestPathTree<T>();
+    }
+    if (dag == nullptr) {
+        std::cout << "DAG paths require an acyclic graph." << std::endl;
+        return ShortestPathTree<T>();
+    }
+
+    DijkstraWorkspace &workspace = ThreadWorkspace();
+    DagPathsIds(g, sourceVertexIndex, -1, *dag, longest, workspace);
+    return ShortestPathTree<T>(g.GetIndex(), sourceVertexIndex, workspace.ExportDistances(g.GetSize()), workspace.ExportPredecessors(g.GetSize()));
+}
+
+// Topological levels (wavefronts): level 0 holds the vertices without incoming arcs and level i + 1 those
+// whose last predecessor is in level i, so the vertices of one level do not depend on each other. The
+// in-degrees are atomic counters; every level is expanded in chunks in parallel on the pool, appending the
+// vertices whose counter drops to zero to one shared order array. Level i is order[levelBegin[i] ..
+// levelBegin[i + 1]), sorted by slot. Returns false and no levels when g has a cycle.
+template<typename G>
+bool TopologicalLevelsIds(const G &g, ThreadPool &pool, std::vector<int> &order, std::vector<size_t> &levelBegin)
+{
+    const size_t chunk = 1024;
+    size_t numVertices = static_cast<size_t>(g.GetSize());
+    size_t numChunks = (numVertices + chunk - 1) / chunk;
+    std::vector<std::atomic<int>> inDegree(numVertices);
+    for (auto &degree : inDegree) {
+        degree.store(0, std::memory_order_relaxed);
+    }
+    pool.ParallelFor(numChunks, [&](size_t c) {
+        for (size_t u = c * chunk; u < std::min(numVertices, (c + 1) * chunk); u++) {
+            for (const auto &edge : g.OutEdges(static_cast<uint32_t>(u))) {
+                inDegree[edge.GetTarget()].fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+    });
+
+    order.assign(numVertices, -1);
+    levelBegin.assign(1, 0);
+    std::atomic<size_t> tail{0};
+    for (size_t v = 0; v < numVertices; v++) {
+        if (inDegree[v].load(std::memory_order_relaxed) == 0) {
+            order[tail++] = static_cast<int>(v);
+        }
+    }
+    levelBegin.push_back(tail);
+    auto expand = [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; i++) {
+            for (const auto &edge : g.OutEdges(static_cast<uint32_t>(order[i]))) {
+                if (inDegree[edge.GetTarget()].fetch_sub(1, std::memory_order_relaxed) == 1) {
+                    order[tail.fetch_add(1, std::memory_order_relaxed)] = static_cast<int>(edge.GetTarget());
+                }
+            }
+        }
+    };
+    while (levelBegin.back() > levelBegin[levelBegin.size() - 2]) {
+        size_t begin = levelBegin[levelBegin.size() - 2];
+        size_t end = levelBegin.back();
+        if (end - begin <= chunk) {
+            expand(begin, end);
+        } else {
+            pool.ParallelFor((end - begin + chunk - 1) / chunk, [&](size_t c) {
+                expand(begin + c * chunk, std::min(end, begin + (c + 1) * chunk));
+            });
+        }
+        std::sort(order.begin() + end, order.begin() + tail);
+        levelBegin.push_back(tail);
+    }
+    levelBegin.pop_back();
+    if (tail != numVertices) {
+        order.clear();
+        levelBegin.assign(1, 0);
+        return false;
+    }
+    return true;
+}
+
+// Names by level; empty (after the usual error message) when g has a cycle.
+template<typename T, typename G>
+DynamicArray<DynamicArray<T>> TopologicalLevelsSearch(const G &g, ThreadPool &pool)
+{
+    DynamicArray<DynamicArray<T>> levels;
+    std::vector<int> order;
+    std::vector<size_t> levelBegin;
+    if (!TopologicalLevelsIds(g, pool, order, levelBegin)) {
+        std::cout << "Error: The graph contains a cycle. Topological sort is not possible." << std::endl;
+        return levels;
+    }
+    for (size_t level = 0; level + 1 < levelBegin.size(); level++) {
+        DynamicArray<T> names;
+        for (size_t i = levelBegin[level]; i < levelBegin[level + 1]; i++) {
+            names.push_back(g.GetVertexName(order[i]));
+        }
+        levels.push_back(std::move(names));
+    }
+    return levels;
+}
+
+// Appends the order to result, or prints the error and one cycle.
+template<typename G, typename T>
+void TopologicalSort(const G &g, DynamicArray<T> &result)
+{
+    TopologicalOrder<T> sorted = TopologicalOrderSearch<T>(g);
+    if (!sorted.IsAcyclic()) {
+        std::cout << "Error: The graph contains a cycle. Topological sort is not possible." << std::endl;
+        std::cout << "Cycle:";
+        for (const auto &vertex : sorted.GetCycle()) {
+            std::cout << " " << vertex;
+        }
+        std::cout << " " << sorted.GetCycle()[0] << std::endl;
+        return;
+    }
+    for (const auto &vertex : sorted.GetOrder()) {
+        result.push_back(vertex);
+    }
+}
+
+#endif // GRAPHALGORITHMS_H
@@ -0,0 +1,81 @@
+#ifndef GRAPHLISTENER_H
+#define GRAPHLISTENER_H
+
+#include <vector>
+#include <algorithm>
+
+// Receives every change made to a Graph, right after it has been applied, in graph slots. After
+// OnVertexRemoved(slot) every slot above it has moved down by one.
+class GraphListener
+{
+public:
+    virtual ~GraphListener() = default;
+
+    virtual void OnVertexAdded(int /*slot*/) {}
+
+    virtual void OnArcAdded(int /*from*/, int /*to*/, int /*weight*/) {}
+
+    virtual void OnArcRemoved(int /*from*/, int /*to*/) {}
+
+    virtual void OnVertexRemoved(int /*slot*/) {}
+
+    // The graph is destroyed or overwritten by assignment; no further calls follow.
+    virtual void OnGraphDetached() {}
+};
+
+// The listeners registered with one Graph object. Copies of a graph start without listeners.
+class GraphListenerList
+{
+private:
+    std::vector<GraphListener *> listeners;
+
+    void DetachAll()
+    {
+        std::vector<GraphListener *> detached;
+        detached.swap(listeners);
+        for (GraphListener *listener : detached) {
+            listener->OnGraphDetached();
+        }
+    }
+
+public:
+    GraphListenerList() = default;
+
+    GraphListenerList(const GraphListenerList &) {}
+
+    GraphListenerList &operator=(const GraphListenerList &)
+    {
+        DetachAll();
+        return *this;
+    }
+
+    ~GraphListenerList()
+    {
+        DetachAll();
+    }
+
+    void Add(GraphListener *listener)
+    {
+        listeners.push_back(listener);
+    }
+
+    void Remove(GraphListener *listener)
+    {
+        listeners.erase(std::remove(listeners.begin(), listeners.end(), listener), listeners.end());
+    }
+
+    bool IsEmpty() const
+    {
+        return listeners.empty();
+    }
+
+    template<typename Call>
+    void Notify(Call &&call) const
+    {
+        for (GraphListener *listener : listeners) {
+            call(*listener);
+        }
+    }
+};
+
+#endif // GRAPHLISTENER_H
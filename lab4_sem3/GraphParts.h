@@ -1,60 +1,178 @@
 #ifndef GRAPHPARTS_H
 #define GRAPHPARTS_H
 
-#include <list>
+#include "DynamicArray.h"
+#include <cstdint>
 
 
-template<typename T>
+// Outgoing arc stored in the adjacency of its source vertex: the source is implied by the owner,
+// the target is the dense slot of the destination vertex in the graph.
 class Edge
 {
 private:
-    T VertexName1;
-    T VertexName2;
+    uint32_t target;
     int weight;
 public:
-    Edge(T vertex1, T vertex2, int weight) : VertexName1(vertex1), VertexName2(vertex2), weight(weight) {}
-
-    Edge(Edge const &edge) : VertexName1(edge.VertexName1), VertexName2(edge.VertexName2), weight(edge.weight) {}
+    Edge(uint32_t target, int weight) : target(target), weight(weight) {}
 
     int GetWeight() const
     {
         return weight;
     }
 
-    T GetFirst() const
+    uint32_t GetTarget() const
     {
-        return VertexName1;
+        return target;
     }
+};
 
-    T GetLast() const
+// Non-owning view over parallel target/weight arrays that iterates as Edge values.
+class EdgeRange
+{
+private:
+    const uint32_t *targets;
+    const int *weights;
+    size_t count;
+public:
+    class iterator
     {
-        return VertexName2;
+    private:
+        const uint32_t *target;
+        const int *weight;
+    public:
+        iterator(const uint32_t *target, const int *weight) : target(target), weight(weight) {}
+
+        Edge operator*() const
+        {
+            return Edge(*target, *weight);
+        }
+
+        iterator &operator++()
+        {
+            ++target;
+            ++weight;
+            return *this;
+        }
+
+        bool operator!=(const iterator &other) const
+        {
+            return target != other.target;
+        }
+    };
+
+    EdgeRange(const uint32_t *targets, const int *weights, size_t count) : targets(targets), weights(weights), count(count) {}
+
+    iterator begin() const
+    {
+        return iterator(targets, weights);
     }
 
-    void Reverse()
+    iterator end() const
     {
-        T tmp = VertexName1;
-        VertexName1 = VertexName2;
-        VertexName2 = tmp;
+        return iterator(targets + count, weights + count);
+    }
+
+    size_t size() const
+    {
+        return count;
+    }
+
+    bool empty() const
+    {
+        return count == 0;
     }
 };
 
+// Arcs kept in two parallel arrays (targets, weights), so a neighbor scan is a linear sweep.
+class AdjacencyList
+{
+private:
+    DynamicArray<uint32_t> targets;
+    DynamicArray<int> weights;
+public:
+    EdgeRange GetEdges() const
+    {
+        return EdgeRange(targets.get_data(), weights.get_data(), targets.get_size());
+    }
+
+    size_t GetSize() const
+    {
+        return targets.get_size();
+    }
+
+    void Add(const Edge &edge)
+    {
+        targets.push_back(edge.GetTarget());
+        weights.push_back(edge.GetWeight());
+    }
+
+    int Find(uint32_t target) const
+    {
+        for (size_t i = 0; i < targets.get_size(); i++) {
+            if (targets[i] == target) {
+                return static_cast<int>(i);
+            }
+        }
+        return -1;
+    }
+
+    // O(1): the last edge takes the place of the removed one, so edge order is not preserved.
+    void RemoveAt(size_t position)
+    {
+        size_t last = targets.get_size() - 1;
+        targets[position] = targets[last];
+        weights[position] = weights[last];
+        targets.pop_back();
+        weights.pop_back();
+    }
+
+    void RemoveAllTo(uint32_t target)
+    {
+        for (size_t i = 0; i < targets.get_size();) {
+            if (targets[i] == target) {
+                RemoveAt(i);
+            } else {
+                ++i;
+            }
+        }
+    }
+
+    // Slots after a removed vertex shift down by one, so do the targets pointing at them.
+    void ShiftTargetsAbove(uint32_t removed)
+    {
+        for (size_t i = 0; i < targets.get_size(); i++) {
+            if (targets[i] > removed) {
+                --targets[i];
+            }
+        }
+    }
+};
+
+// A vertex owns its outgoing arcs and a mirror of its incoming arcs (the target of an
+// incoming Edge is the source vertex), which the backward searches walk.
 template<typename T>
 class Vertex
 {
 private:
     T name;
-    std::list<Edge<T>> edges;
+    AdjacencyList edges;
+    AdjacencyList inEdges;
 public:
-    Vertex() : name(), edges() {};
+    Vertex() : name(), edges(), inEdges() {};
 
     Vertex(T name) : name(name) {};
 
-    std::list<Edge<T>>& GetEdges() {
-        return edges;
+    EdgeRange GetEdges() const {
+        return edges.GetEdges();
     }
-    const std::list<Edge<T>>& GetEdges() const {
-        return edges;
+
+    EdgeRange GetInEdges() const {
+        return inEdges.GetEdges();
+    }
+
+    size_t GetDegree() const
+    {
+        return edges.GetSize();
     }
 
     T GetName() const
@@ -62,9 +180,35 @@ public:
         return name;
     }
 
-    void AddEdgeV(const Edge<T> &edge)
+    void AddEdgeV(const Edge &edge)
+    {
+        edges.Add(edge);
+    }
+
+    void AddInEdge(const Edge &edge)
+    {
+        inEdges.Add(edge);
+    }
+
+    int FindEdge(uint32_t target) const
+    {
+        return edges.Find(target);
+    }
+
+    void RemoveEdgesTo(uint32_t target)
+    {
+        edges.RemoveAllTo(target);
+    }
+
+    void RemoveInEdgesFrom(uint32_t source)
+    {
+        inEdges.RemoveAllTo(source);
+    }
+
+    void ShiftSlotsAbove(uint32_t removed)
     {
-        edges.push_back(edge);
+        edges.ShiftTargetsAbove(removed);
+        inEdges.ShiftTargetsAbove(removed);
     }
 
 };
@@ -0,0 +1,251 @@
+#ifndef INCREMENTALTOPOLOGICALORDER_H
+#define INCREMENTALTOPOLOGICALORDER_H
+
+#include "Graph.h"
+#include "GraphListener.h"
+#include "GraphAlgorithms.h"
+#include <vector>
+#include <algorithm>
+
+// Topological order of a DAG that follows arc insertions (Pearce-Kelly). position[slot] is the place of a
+// vertex in the order. A new arc x -> y with position[y] < position[x] only concerns the vertices placed
+// between them: a forward search from y and a backward search from x, both confined to that window, find
+// the vertices that must move (or x itself, which means a cycle), and those are re-placed on their own old
+// positions, the ones that reach x first. The cost follows the window, not the graph. Arc removals keep the
+// order valid. Adding or removing a vertex renumbers positions or slots and costs O(V).
+// Arcs should be added through TryAddArc, which refuses those that would close a cycle; an arc that closes a
+// cycle through Graph::AddArc directly makes the order invalid until Rebuild() on an acyclic graph.
+template<typename T>
+class IncrementalTopologicalOrder : public GraphListener
+{
+private:
+    Graph<T> *graph;
+    bool valid = false;
+    std::vector<int> position;
+    std::vector<int> slotAt;
+    std::vector<bool> visited;
+    std::vector<int> forward;
+    std::vector<int> backward;
+    std::vector<int> stack;
+    size_t lastSearchSize = 0;
+
+    // Collects into found every unvisited vertex reachable from start along OutEdges (forwardSide) or InEdges
+    // whose position is strictly inside (low, high); false as soon as one at position stopAt is reached.
+    bool Search(int start, bool forwardSide, int low, int high, int stopAt, std::vector<int> &found)
+    {
+        visited[start] = true;
+        found.push_back(start);
+        stack.assign(1, start);
+        while (!stack.empty()) {
+            int u = stack.back();
+            stack.pop_back();
+            for (const auto &edge : forwardSide ? graph->OutEdges(u) : graph->InEdges(u)) {
+                int v = static_cast<int>(edge.GetTarget());
+                if (position[v] == stopAt) {
+                    return false;
+                }
+                if (!visited[v] && position[v] > low && position[v] < high) {
+                    visited[v] = true;
+                    found.push_back(v);
+                    stack.push_back(v);
+                }
+            }
+        }
+        return true;
+    }
+
+    // Makes room for the arc from -> to; false when it would close a cycle, leaving the order as it was.
+    bool Insert(int from, int to)
+    {
+        lastSearchSize = 0;
+        int lower = position[to];
+        int upper = position[from];
+        if (lower > upper) {
+            return true;
+        }
+        if (from == to) {
+            return false;
+        }
+
+        forward.clear();
+        backward.clear();
+        bool acyclic = Search(to, true, lower, upper, upper, forward);
+        if (acyclic) {
+            Search(from, false, lower, upper, -1, backward);
+        }
+        for (int v : forward) {
+            visited[v] = false;
+        }
+        for (int v : backward) {
+            visited[v] = false;
+        }
+        lastSearchSize = forward.size() + backward.size();
+        if (!acyclic) {
+            return false;
+        }
+
+        auto byPosition = [this](int a, int b) { return position[a] < position[b]; };
+        std::sort(forward.begin(), forward.end(), byPosition);
+        std::sort(backward.begin(), backward.end(), byPosition);
+        std::vector<int> places;
+        for (int v : backward) {
+            places.push_back(position[v]);
+        }
+        for (int v : forward) {
+            places.push_back(position[v]);
+        }
+        std::sort(places.begin(), places.end());
+        size_t next = 0;
+        for (int v : backward) {
+            position[v] = places[next++];
+            slotAt[position[v]] = v;
+        }
+        for (int v : forward) {
+            position[v] = places[next++];
+            slotAt[position[v]] = v;
+        }
+        return true;
+    }
+
+public:
+    explicit IncrementalTopologicalOrder(Graph<T> &graph_) : graph(&graph_)
+    {
+        graph->AddListener(this);
+        Rebuild();
+    }
+
+    IncrementalTopologicalOrder(const IncrementalTopologicalOrder &) = delete;
+    IncrementalTopologicalOrder &operator=(const IncrementalTopologicalOrder &) = delete;
+
+    ~IncrementalTopologicalOrder() override
+    {
+        if (graph != nullptr) {
+            graph->RemoveListener(this);
+        }
+    }
+
+    // Full sort, as after construction; prints the error if the graph has a cycle.
+    void Rebuild()
+    {
+        valid = false;
+        position.clear();
+        slotAt.clear();
+        if (graph == nullptr) {
+            return;
+        }
+        std::vector<int> cycle;
+        if (!TopologicalSortIds(*graph, slotAt, cycle)) {
+            std::cout << "Error: The graph contains a cycle. Topological sort is not possible." << std::endl;
+            return;
+        }
+        position.assign(slotAt.size(), 0);
+        for (size_t i = 0; i < slotAt.size(); i++) {
+            position[slotAt[i]] = static_cast<int>(i);
+        }
+        visited.assign(slotAt.size(), false);
+        valid = true;
+    }
+
+    // False when the graph is gone or got a cycle behind the order's back.
+    bool IsValid() const
+    {
+        return valid;
+    }
+
+    // Adds the arc unless it would close a cycle, in which case the graph is left unchanged and false is
+    // returned. Works like Graph::AddArc otherwise.
+    bool TryAddArc(T vertexName1, T vertexName2, int weight)
+    {
+        if (!valid) {
+            std::cout << "Topological order is not valid." << std::endl;
+            return false;
+        }
+        int from = graph->FindSlot(vertexName1);
+        int to = graph->FindSlot(vertexName2);
+        if (from == -1 || to == -1) {
+            std::cout << "One or both vertices do not exist." << std::endl;
+            return false;
+        }
+        if (!Insert(from, to)) {
+            std::cout << "Arc from " << vertexName1 << " to " << vertexName2 << " would create a cycle." << std::endl;
+            return false;
+        }
+        // The notification finds the arc already in order; keep the size of the real search.
+        size_t searched = lastSearchSize;
+        graph->AddArc(vertexName1, vertexName2, weight);
+        lastSearchSize = searched;
+        return true;
+    }
+
+    // Vertices moved or visited by the last arc insertion.
+    size_t GetLastSearchSize() const
+    {
+        return lastSearchSize;
+    }
+
+    // Empty when the order is not valid.
+    DynamicArray<T> GetOrder() const
+    {
+        DynamicArray<T> order;
+        if (valid) {
+            for (int slot : slotAt) {
+                order.push_back(graph->GetVertexName(slot));
+            }
+        }
+        return order;
+    }
+
+    // Place of the vertex in the order; -1 when it is unknown or the order is not valid.
+    int GetPosition(T vertexName) const
+    {
+        int slot = valid ? graph->FindSlot(vertexName) : -1;
+        return slot == -1 ? -1 : position[slot];
+    }
+
+    void OnVertexAdded(int slot) override
+    {
+        if (!valid) {
+            return;
+        }
+        for (int &at : slotAt) {
+            if (at >= slot) {
+                ++at;
+            }
+        }
+        position.insert(position.begin() + slot, static_cast<int>(slotAt.size()));
+        slotAt.push_back(slot);
+        visited.push_back(false);
+    }
+
+    void OnArcAdded(int from, int to, int /*weight*/) override
+    {
+        if (valid && !Insert(from, to)) {
+            std::cout << "Error: The graph contains a cycle. Topological sort is not possible." << std::endl;
+            valid = false;
+        }
+    }
+
+    void OnVertexRemoved(int slot) override
+    {
+        if (!valid) {
+            return;
+        }
+        slotAt.erase(slotAt.begin() + position[slot]);
+        position.erase(position.begin() + slot);
+        visited.pop_back();
+        for (size_t i = 0; i < slotAt.size(); i++) {
+            if (slotAt[i] > slot) {
+                --slotAt[i];
+            }
+            position[slotAt[i]] = static_cast<int>(i);
+        }
+    }
+
+    void OnGraphDetached() override
+    {
+        graph = nullptr;
+        valid = false;
+    }
+};
+
+#endif // INCREMENTALTOPOLOGICALORDER_H
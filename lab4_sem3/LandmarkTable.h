@@ -0,0 +1,217 @@
+#ifndef LANDMARKTABLE_H
+#define LANDMARKTABLE_H
+
+#include "DynamicArray.h"
+#include "DistanceMatrix.h"
+#include "DijkstraWorkspace.h"
+#include "GraphAlgorithms.h"
+#include <iostream>
+#include <vector>
+#include <cstdint>
+
+// Hash of the arcs of g by slot, so that a table saved for one graph is not used on another.
+template<typename G>
+uint64_t GraphFingerprint(const G &g)
+{
+    uint64_t hash = 14695981039346656037ull;
+    auto mix = [&hash](uint64_t value) {
+        hash ^= value;
+        hash *= 1099511628211ull;
+    };
+    mix(static_cast<uint64_t>(g.GetSize()));
+    for (int u = 0; u < g.GetSize(); u++) {
+        for (const auto &edge : g.OutEdges(static_cast<uint32_t>(u))) {
+            mix((uint64_t(uint32_t(u)) << 32) | edge.GetTarget());
+            mix(uint64_t(uint32_t(edge.GetWeight())));
+        }
+    }
+    return hash;
+}
+
+// ALT (A*, landmarks, triangle inequality) lower bounds. For every landmark L the table keeps d(L, v) and
+// d(v, L) for all slots v, stored per vertex so that the k bounds of one vertex are contiguous:
+//   d(v, t) >= d(L, t) - d(L, v)   and   d(v, t) >= d(v, L) - d(t, L).
+// Each landmark is the vertex farthest from the ones picked so far (unreachable ones first). The table
+// is tied to the slots of the graph it was built from.
+class LandmarkTable
+{
+private:
+    DynamicArray<int> landmarks;
+    DistanceMatrix fromLandmark; // (v, i) = d(landmark i, v)
+    DistanceMatrix toLandmark;   // (v, i) = d(v, landmark i)
+    uint64_t fingerprint = 0;
+
+public:
+    LandmarkTable() : landmarks(0) {}
+
+    // Needs non-negative weights; count is capped at the number of vertices.
+    template<typename G>
+    LandmarkTable(const G &g, int count) : landmarks(0)
+    {
+        if (g.GetMinWeight() < 0) {
+            std::cout << "Landmarks require non-negative weights." << std::endl;
+            return;
+        }
+        int numVertices = g.GetSize();
+        count = std::max(0, std::min(count, numVertices));
+        fingerprint = GraphFingerprint(g);
+        fromLandmark = DistanceMatrix(numVertices, count);
+        toLandmark = DistanceMatrix(numVertices, count);
+        if (count == 0) {
+            return;
+        }
+
+        // Distance to the nearest landmark so far; unreachable vertices count as the farthest.
+        DijkstraWorkspace &workspace = ThreadWorkspace();
+        DijkstraIds(g, 0, DijkstraQueue::Auto, workspace, StopAtVertex{-1});
+        std::vector<int> nearest(numVertices);
+        for (int v = 0; v < numVertices; v++) {
+            nearest[v] = workspace.GetDistance(v);
+        }
+
+        for (int i = 0; i < count; i++) {
+            int landmark = static_cast<int>(std::max_element(nearest.begin(), nearest.end()) - nearest.begin());
+            landmarks.push_back(landmark);
+
+            DijkstraIds(g, landmark, DijkstraQueue::Auto, workspace, StopAtVertex{-1});
+            for (int v = 0; v < numVertices; v++) {
+                fromLandmark(v, i) = workspace.GetDistance(v);
+                nearest[v] = std::min(nearest[v], workspace.GetDistance(v));
+            }
+            DijkstraIds(ReverseGraph<G>(g), landmark, DijkstraQueue::Auto, workspace, StopAtVertex{-1});
+            for (int v = 0; v < numVertices; v++) {
+                toLandmark(v, i) = workspace.GetDistance(v);
+            }
+            nearest[landmark] = -1;
+        }
+    }
+
+    int GetSize() const
+    {
+        return static_cast<int>(fromLandmark.GetRows());
+    }
+
+    int GetLandmarkCount() const
+    {
+        return static_cast<int>(landmarks.get_size());
+    }
+
+    const DynamicArray<int>& GetLandmarks() const
+    {
+        return landmarks;
+    }
+
+    // Largest triangle-inequality bound on d(slot, target); a landmark that cannot reach or be reached
+    // from one of the two gives no bound.
+    int LowerBound(int slot, int target) const
+    {
+        const int *fromV = fromLandmark.GetRow(slot).begin();
+        const int *fromT = fromLandmark.GetRow(target).begin();
+        const int *toV = toLandmark.GetRow(slot).begin();
+        const int *toT = toLandmark.GetRow(target).begin();
+        int bound = 0;
+        for (size_t i = 0; i < landmarks.get_size(); i++) {
+            if (fromV[i] != INT_MAX && fromT[i] != INT_MAX) {
+                bound = std::max(bound, fromT[i] - fromV[i]);
+            }
+            if (toV[i] != INT_MAX && toT[i] != INT_MAX) {
+                bound = std::max(bound, toV[i] - toT[i]);
+            }
+        }
+        return bound;
+    }
+
+    template<typename G>
+    bool Matches(const G &g) const
+    {
+        return GetSize() == g.GetSize() && fingerprint == GraphFingerprint(g);
+    }
+
+    // Binary dump in the machine's byte order, meant to be read back on the same platform.
+    void Save(std::ostream &out) const
+    {
+        const char magic[4] = {'A', 'L', 'T', '1'};
+        uint64_t header[3] = {fingerprint, fromLandmark.GetRows(), landmarks.get_size()};
+        out.write(magic, sizeof(magic));
+        out.write(reinterpret_cast<const char *>(header), sizeof(header));
+        out.write(reinterpret_cast<const char *>(landmarks.get_data()), sizeof(int) * landmarks.get_size());
+        size_t cells = fromLandmark.GetRows() * fromLandmark.GetCols();
+        out.write(reinterpret_cast<const char *>(fromLandmark.GetData()), sizeof(int) * cells);
+        out.write(reinterpret_cast<const char *>(toLandmark.GetData()), sizeof(int) * cells);
+    }
+
+    // Reads a table written by Save and keeps it only if it was built for g.
+    template<typename G>
+    bool Load(std::istream &in, const G &g)
+    {
+        char magic[4];
+        uint64_t header[3];
+        in.read(magic, sizeof(magic));
+        in.read(reinterpret_cast<char *>(header), sizeof(header));
+        if (!in || magic[0] != 'A' || magic[1] != 'L' || magic[2] != 'T' || magic[3] != '1') {
+            std::cout << "Not a landmark table." << std::endl;
+            return false;
+        }
+        if (header[0] != GraphFingerprint(g) || header[1] != static_cast<uint64_t>(g.GetSize())) {
+            std::cout << "Landmark table was built for a different graph." << std::endl;
+            return false;
+        }
+        // The counts are checked against the graph and, when the stream can tell, its length before anything
+        // is allocated from them.
+        if (header[2] > header[1]) {
+            std::cout << "Landmark table is corrupt." << std::endl;
+            return false;
+        }
+        size_t count = static_cast<size_t>(header[2]);
+        size_t numVertices = static_cast<size_t>(header[1]);
+        uint64_t neededInts = header[2] * (1 + 2 * header[1]);
+        std::streampos here = in.tellg();
+        if (here != std::streampos(-1)) {
+            in.seekg(0, std::ios::end);
+            std::streampos end = in.tellg();
+            in.clear();
+            in.seekg(here);
+            if (end != std::streampos(-1) && static_cast<uint64_t>(end - here) / sizeof(int) < neededInts) {
+                std::cout << "Landmark table is truncated." << std::endl;
+                return false;
+            }
+        }
+        DynamicArray<int> loadedLandmarks(count);
+        DistanceMatrix loadedFrom(numVertices, count);
+        DistanceMatrix loadedTo(numVertices, count);
+        in.read(reinterpret_cast<char *>(loadedLandmarks.get_data()), sizeof(int) * count);
+        in.read(reinterpret_cast<char *>(loadedFrom.GetData()), sizeof(int) * numVertices * count);
+        in.read(reinterpret_cast<char *>(loadedTo.GetData()), sizeof(int) * numVertices * count);
+        if (!in) {
+            std::cout << "Landmark table is truncated." << std::endl;
+            return false;
+        }
+
+        fingerprint = header[0];
+        landmarks = std::move(loadedLandmarks);
+        fromLandmark = std::move(loadedFrom);
+        toLandmark = std::move(loadedTo);
+        return true;
+    }
+};
+
+// A* guided by the landmark bounds; prints like Dijkstra.
+template<typename G, typename T>
+Path<T> LandmarkSearch(const G &g, T startVertexName, T endVertexName, const LandmarkTable &landmarks)
+{
+    int startVertexIndex, endVertexIndex;
+    if (!ResolveEndpoints(g, startVertexName, endVertexName, startVertexIndex, endVertexIndex)) {
+        return Path<T>();
+    }
+    if (landmarks.GetSize() != g.GetSize()) {
+        std::cout << "Landmark table does not match the graph." << std::endl;
+        return Path<T>();
+    }
+
+    DijkstraWorkspace &workspace = ThreadWorkspace();
+    AStarIds(g, startVertexIndex, endVertexIndex, [&](int slot) { return landmarks.LowerBound(slot, endVertexIndex); }, workspace);
+
+    return FinishPath(g, startVertexName, endVertexName, endVertexIndex, workspace);
+}
+
+#endif // LANDMARKTABLE_H
@@ -2,6 +2,9 @@
 #define PATH_H
 
 #include "DynamicArray.h"
+#include "ArrayView.h"
+#include <utility>
+#include <climits>
 
 template<typename T>
 class Path
@@ -9,24 +12,65 @@ class Path
 private:
     DynamicArray<int> distances;
     DynamicArray<T> path;
+    int length = INT_MAX;
 public:
     Path() = default;
 
-    Path(DynamicArray<int>& distances_, DynamicArray<T>& path_)
+    Path(DynamicArray<int>& distances_, DynamicArray<T>& path_, int length_ = INT_MAX)
     {
         distances = distances_;
         path = path_;
+        length = length_;
     }
 
-    DynamicArray<int> GetDistances()
+    Path(DynamicArray<int>&& distances_, DynamicArray<T>&& path_, int length_ = INT_MAX)
+        : distances(std::move(distances_)), path(std::move(path_)), length(length_)
+    {
+    }
+
+    // Total weight of the path; INT_MAX when there is none.
+    int GetLength() const
+    {
+        return length;
+    }
+
+    const DynamicArray<int>& GetDistances() const &
     {
         return distances;
     }
 
-    DynamicArray<T> GetPath()
+    // On a temporary Path the arrays are moved out instead of copied.
+    DynamicArray<int> GetDistances() &&
+    {
+        return std::move(distances);
+    }
+
+    const DynamicArray<T>& GetPath() const &
     {
         return path;
     }
+
+    DynamicArray<T> GetPath() &&
+    {
+        return std::move(path);
+    }
+
+    ArrayView<int> GetDistancesView() const
+    {
+        return ArrayView<int>(distances);
+    }
+
+    ArrayView<T> GetPathView() const
+    {
+        return ArrayView<T>(path);
+    }
+
+    // Moves both arrays out (distances first); the Path is left empty, with no length.
+    std::pair<DynamicArray<int>, DynamicArray<T>> Release()
+    {
+        length = INT_MAX;
+        return std::make_pair(std::move(distances), std::move(path));
+    }
 };
 
 #endif // PATH_H
@@ -0,0 +1,80 @@
+#ifndef SHORTESTPATHTREE_H
+#define SHORTESTPATHTREE_H
+
+#include "DynamicArray.h"
+#include "VertexIndex.h"
+#include <climits>
+
+// Result of a full single-source search: distance and predecessor per slot. Paths are rebuilt on
+// request in O(path length). The tree keeps its own copy of the searched graph's index, so it stays
+// usable after that graph changes or goes away.
+template<typename T>
+class ShortestPathTree
+{
+private:
+    VertexIndex<T> index;
+    int source = -1;
+    DynamicArray<int> distances;
+    DynamicArray<int> prev;
+
+    int SlotOf(T vertexName) const
+    {
+        return source == -1 ? -1 : index.Find(vertexName);
+    }
+public:
+    ShortestPathTree() = default;
+
+    ShortestPathTree(const VertexIndex<T> &index_, int source_, DynamicArray<int> &&distances_, DynamicArray<int> &&prev_)
+        : index(index_), source(source_), distances(std::move(distances_)), prev(std::move(prev_))
+    {
+    }
+
+    bool IsEmpty() const
+    {
+        return source == -1;
+    }
+
+    T GetSource() const
+    {
+        return index.GetName(source);
+    }
+
+    bool HasPathTo(T target) const
+    {
+        int slot = SlotOf(target);
+        return slot != -1 && distances[slot] != INT_MAX;
+    }
+
+    // INT_MAX when the target is unknown or unreachable.
+    int GetDistance(T target) const
+    {
+        int slot = SlotOf(target);
+        return slot == -1 ? INT_MAX : distances[slot];
+    }
+
+    // Empty when the target is unknown or unreachable.
+    DynamicArray<T> GetPathTo(T target) const
+    {
+        DynamicArray<T> path;
+        if (!HasPathTo(target)) {
+            return path;
+        }
+        for (int at = SlotOf(target); at != -1; at = prev[at]) {
+            path.push_back(index.GetName(at));
+        }
+        std::reverse(path.begin(), path.end());
+        return path;
+    }
+
+    const DynamicArray<int>& GetDistances() const
+    {
+        return distances;
+    }
+
+    const DynamicArray<int>& GetPredecessors() const
+    {
+        return prev;
+    }
+};
+
+#endif // SHORTESTPATHTREE_H
@@ -0,0 +1,218 @@
+#ifndef STRONGLYCONNECTEDCOMPONENTS_H
+#define STRONGLYCONNECTEDCOMPONENTS_H
+
+#include "DynamicArray.h"
+#include "VertexIndex.h"
+#include "CsrGraph.h"
+#include <vector>
+#include <utility>
+
+// Pearce's variant of Tarjan's algorithm with an explicit call stack, so depth is not limited by the thread's
+// stack. rindex doubles as the low-link while a vertex is active and as its component number once its
+// component is complete; completed numbers count down from V - 1, above every active rindex, so no separate
+// on-stack flag is needed. Components complete sinks first, which makes the ids returned in component
+// (0 .. count - 1) a topological order of the condensation. O(V + E), about three ints per vertex.
+template<typename G>
+int StronglyConnectedComponentsIds(const G &g, std::vector<int> &component)
+{
+    using EdgeIterator = decltype(g.OutEdges(0).begin());
+    struct Frame
+    {
+        int vertex;
+        EdgeIterator next;
+        EdgeIterator end;
+    };
+    int numVertices = g.GetSize();
+    std::vector<int> &rindex = component;
+    rindex.assign(numVertices, 0);
+    std::vector<bool> root(numVertices, false);
+    std::vector<int> pending;
+    std::vector<Frame> calls;
+    int nextIndex = 1;
+    int nextComponent = numVertices - 1;
+
+    auto visit = [&](int v) {
+        rindex[v] = nextIndex++;
+        root[v] = true;
+        calls.push_back(Frame{v, g.OutEdges(static_cast<uint32_t>(v)).begin(), g.OutEdges(static_cast<uint32_t>(v)).end()});
+    };
+    auto lower = [&](int v, int w) {
+        if (rindex[w] < rindex[v]) {
+            rindex[v] = rindex[w];
+            root[v] = false;
+        }
+    };
+
+    for (int start = 0; start < numVertices; start++) {
+        if (rindex[start] != 0) {
+            continue;
+        }
+        visit(start);
+        while (!calls.empty()) {
+            Frame &frame = calls.back();
+            int v = frame.vertex;
+            if (frame.next != frame.end) {
+                int w = static_cast<int>((*frame.next).GetTarget());
+                ++frame.next;
+                if (rindex[w] == 0) {
+                    visit(w);
+                } else {
+                    lower(v, w);
+                }
+                continue;
+            }
+
+            calls.pop_back();
+            if (root[v]) {
+                --nextIndex;
+                while (!pending.empty() && rindex[v] <= rindex[pending.back()]) {
+                    rindex[pending.back()] = nextComponent;
+                    pending.pop_back();
+                    --nextIndex;
+                }
+                rindex[v] = nextComponent--;
+            } else {
+                pending.push_back(v);
+            }
+            if (!calls.empty()) {
+                lower(calls.back().vertex, v);
+            }
+        }
+    }
+
+    int count = numVertices - 1 - nextComponent;
+    for (int v = 0; v < numVertices; v++) {
+        rindex[v] -= nextComponent + 1;
+    }
+    return count;
+}
+
+// Condensation: one vertex per component, named by its id, and one arc between two components for every
+// pair joined by at least one arc, carrying the smallest such weight. Arcs inside a component are dropped,
+// so the result is a DAG whose arcs all go from a lower id to a higher one. O(V + E).
+template<typename G>
+CsrGraph<int> CondensationIds(const G &g, const std::vector<int> &component, int count)
+{
+    int numVertices = g.GetSize();
+    // Vertices grouped by component.
+    std::vector<int> memberBegin(count + 1, 0);
+    for (int v = 0; v < numVertices; v++) {
+        ++memberBegin[component[v] + 1];
+    }
+    for (int c = 0; c < count; c++) {
+        memberBegin[c + 1] += memberBegin[c];
+    }
+    std::vector<int> members(numVertices);
+    std::vector<int> next(memberBegin.begin(), memberBegin.end() - 1);
+    for (int v = 0; v < numVertices; v++) {
+        members[next[component[v]]++] = v;
+    }
+
+    DynamicArray<uint32_t> offsets(static_cast<size_t>(count) + 1);
+    DynamicArray<uint32_t> targets;
+    DynamicArray<int> weights;
+    // seenFrom[d] is the last component that got an arc to d, at position arcAt[d].
+    std::vector<int> seenFrom(count, -1);
+    std::vector<uint32_t> arcAt(count);
+    offsets[0] = 0;
+    for (int c = 0; c < count; c++) {
+        for (int i = memberBegin[c]; i < memberBegin[c + 1]; i++) {
+            for (const auto &edge : g.OutEdges(static_cast<uint32_t>(members[i]))) {
+                int d = component[edge.GetTarget()];
+                if (d == c) {
+                    continue;
+                }
+                if (seenFrom[d] != c) {
+                    seenFrom[d] = c;
+                    arcAt[d] = static_cast<uint32_t>(targets.get_size());
+                    targets.push_back(static_cast<uint32_t>(d));
+                    weights.push_back(edge.GetWeight());
+                } else {
+                    weights[arcAt[d]] = std::min(weights[arcAt[d]], edge.GetWeight());
+                }
+            }
+        }
+        offsets[c + 1] = static_cast<uint32_t>(targets.get_size());
+    }
+
+    VertexIndex<int> index;
+    for (int c = 0; c < count; c++) {
+        index.Insert(c);
+    }
+    return CsrGraph<int>(index, std::move(offsets), std::move(targets), std::move(weights));
+}
+
+// Component id of every vertex of a graph; the ids are a topological order of the condensation. It keeps its
+// own copy of the searched graph's index, so it stays usable after that graph changes or goes away.
+template<typename T>
+class StronglyConnectedComponents
+{
+private:
+    VertexIndex<T> index;
+    std::vector<int> component;
+    std::vector<int> sizes;
+    std::vector<bool> cyclic;
+public:
+    StronglyConnectedComponents() = default;
+
+    template<typename G>
+    explicit StronglyConnectedComponents(const G &g) : index(g.GetIndex())
+    {
+        int count = StronglyConnectedComponentsIds(g, component);
+        sizes.assign(count, 0);
+        for (int id : component) {
+            ++sizes[id];
+        }
+        cyclic.assign(count, false);
+        for (int u = 0; u < g.GetSize(); u++) {
+            for (const auto &edge : g.OutEdges(static_cast<uint32_t>(u))) {
+                if (component[edge.GetTarget()] == component[u]) {
+                    cyclic[component[u]] = true;
+                }
+            }
+        }
+    }
+
+    int GetCount() const
+    {
+        return static_cast<int>(sizes.size());
+    }
+
+    // -1 when the vertex is unknown.
+    int GetComponent(T vertexName) const
+    {
+        int slot = index.Find(vertexName);
+        return slot == -1 ? -1 : component[slot];
+    }
+
+    // Component of every slot.
+    const std::vector<int>& GetComponentIds() const
+    {
+        return component;
+    }
+
+    int GetComponentSize(int id) const
+    {
+        return sizes[id];
+    }
+
+    DynamicArray<T> GetMembers(int id) const
+    {
+        DynamicArray<T> members;
+        for (size_t slot = 0; slot < component.size(); slot++) {
+            if (component[slot] == id) {
+                members.push_back(index.GetName(static_cast<int>(slot)));
+            }
+        }
+        return members;
+    }
+
+    // True for the vertices of a component with an arc inside it: several vertices, or one with a loop.
+    bool IsOnCycle(T vertexName) const
+    {
+        int id = GetComponent(vertexName);
+        return id != -1 && cyclic[id];
+    }
+};
+
+#endif // STRONGLYCONNECTEDCOMPONENTS_H
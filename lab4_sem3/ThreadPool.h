@@ -0,0 +1,128 @@
+#ifndef THREADPOOL_H
+#define THREADPOOL_H
+
+#include <vector>
+#include <queue>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <atomic>
+#include <memory>
+#include <algorithm>
+
+// Fixed set of worker threads fed from one task queue.
+class ThreadPool
+{
+private:
+    std::vector<std::thread> workers;
+    std::queue<std::function<void()>> tasks;
+    std::mutex mutex;
+    std::condition_variable condition;
+    bool stopping = false;
+
+    void WorkerLoop()
+    {
+        for (;;) {
+            std::function<void()> task;
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                condition.wait(lock, [this] { return stopping || !tasks.empty(); });
+                if (stopping && tasks.empty()) {
+                    return;
+                }
+                task = std::move(tasks.front());
+                tasks.pop();
+            }
+            task();
+        }
+    }
+
+public:
+    // 0 threads means one per hardware thread.
+    explicit ThreadPool(unsigned threadCount = 0)
+    {
+        if (threadCount == 0) {
+            threadCount = std::max(1u, std::thread::hardware_concurrency());
+        }
+        for (unsigned i = 0; i < threadCount; i++) {
+            workers.emplace_back([this] { WorkerLoop(); });
+        }
+    }
+
+    ThreadPool(const ThreadPool &) = delete;
+    ThreadPool &operator=(const ThreadPool &) = delete;
+
+    ~ThreadPool()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        condition.notify_all();
+        for (auto &worker : workers) {
+            worker.join();
+        }
+    }
+
+    unsigned GetThreadCount() const
+    {
+        return static_cast<unsigned>(workers.size());
+    }
+
+    void Submit(std::function<void()> task)
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            tasks.push(std::move(task));
+        }
+        condition.notify_one();
+    }
+
+    // Runs body(i) for every i in [0, count) on the workers and the calling thread, handing out indices
+    // one at a time, and returns once all of them are done. The caller takes part, so it also finishes
+    // when called from inside a pool task while every worker is busy.
+    template<typename F>
+    void ParallelFor(size_t count, F &&body)
+    {
+        struct State
+        {
+            std::atomic<size_t> next{0};
+            size_t completed = 0;
+            std::mutex mutex;
+            std::condition_variable condition;
+        };
+        auto state = std::make_shared<State>();
+        auto run = [state, count, &body] {
+            size_t finished = 0;
+            for (size_t i = state->next++; i < count; i = state->next++) {
+                body(i);
+                ++finished;
+            }
+            if (finished > 0) {
+                std::lock_guard<std::mutex> lock(state->mutex);
+                state->completed += finished;
+                if (state->completed == count) {
+                    state->condition.notify_all();
+                }
+            }
+        };
+
+        size_t helpers = std::min<size_t>(workers.size(), count > 0 ? count - 1 : 0);
+        for (size_t i = 0; i < helpers; i++) {
+            Submit(run);
+        }
+        run();
+        std::unique_lock<std::mutex> lock(state->mutex);
+        state->condition.wait(lock, [&] { return state->completed == count; });
+    }
+
+    // Process-wide pool shared by the parallel graph queries.
+    static ThreadPool &Shared()
+    {
+        static ThreadPool pool;
+        return pool;
+    }
+};
+
+#endif // THREADPOOL_H
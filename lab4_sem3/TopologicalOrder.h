@@ -0,0 +1,107 @@
+#ifndef TOPOLOGICALORDER_H
+#define TOPOLOGICALORDER_H
+
+#include "DynamicArray.h"
+#include <utility>
+#include <vector>
+#include <memory>
+#include <mutex>
+
+// Result of a topological sort: either an order of all vertices in which every arc points forward, or,
+// when the graph has a cycle, the vertices of one cycle in arc order (each has an arc to the next one and
+// the last has an arc back to the first).
+template<typename T>
+class TopologicalOrder
+{
+private:
+    DynamicArray<T> order;
+    DynamicArray<T> cycle;
+public:
+    TopologicalOrder() = default;
+
+    TopologicalOrder(DynamicArray<T> &&order_, DynamicArray<T> &&cycle_) : order(std::move(order_)), cycle(std::move(cycle_))
+    {
+    }
+
+    bool IsAcyclic() const
+    {
+        return cycle.is_empty();
+    }
+
+    // Empty when the graph has a cycle.
+    const DynamicArray<T>& GetOrder() const
+    {
+        return order;
+    }
+
+    // Empty when the graph is acyclic.
+    const DynamicArray<T>& GetCycle() const
+    {
+        return cycle;
+    }
+};
+
+// Topological order of the slots of an acyclic graph and the place of every slot in it.
+struct DagOrder
+{
+    std::vector<int> order;
+    std::vector<int> position;
+};
+
+// What a graph knows about its own acyclicity: nothing, an order, or that it has a cycle. It is filled from
+// const member functions, possibly by several threads at once, so it is locked; the graph clears it on the
+// changes that can make it wrong. Copies start empty.
+class DagOrderCache
+{
+private:
+    mutable std::mutex mutex;
+    std::shared_ptr<const DagOrder> order;
+    bool known = false;
+public:
+    DagOrderCache() = default;
+
+    DagOrderCache(const DagOrderCache &) {}
+
+    DagOrderCache &operator=(const DagOrderCache &)
+    {
+        Clear();
+        return *this;
+    }
+
+    // The cached order, computing it with compute() (null for a cyclic graph) if nothing is known yet.
+    template<typename Compute>
+    std::shared_ptr<const DagOrder> Get(Compute &&compute)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (!known) {
+            order = compute();
+            known = true;
+        }
+        return order;
+    }
+
+    // The cached order without computing it; null unless the graph is known to be acyclic.
+    std::shared_ptr<const DagOrder> Peek() const
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        return order;
+    }
+
+    void Clear()
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        order.reset();
+        known = false;
+    }
+
+    // Removing arcs keeps an order valid but may break the only cycle.
+    void ClearIfCyclic()
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (known && order == nullptr) {
+            known = false;
+        }
+    }
+};
+
+#endif // TOPOLOGICALORDER_H
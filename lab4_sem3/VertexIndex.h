@@ -0,0 +1,126 @@
+#ifndef VERTEXINDEX_H
+#define VERTEXINDEX_H
+
+#include "DynamicArray.h"
+#include <functional>
+#include <cstdint>
+
+// Maps vertex names to dense slots 0..size-1 (the positions in Graph::graph).
+// Open addressing with linear probing; the table stores slots, names are kept in slot order.
+template<typename T>
+class VertexIndex
+{
+private:
+    DynamicArray<T> names;
+    DynamicArray<int> table;
+    size_t shift = 64;
+
+    size_t Home(const T &name) const
+    {
+        return static_cast<size_t>((static_cast<uint64_t>(std::hash<T>{}(name)) * 0x9E3779B97F4A7C15ull) >> shift);
+    }
+
+    size_t Mask() const
+    {
+        return table.get_size() - 1;
+    }
+
+    void Rehash(size_t newCapacity)
+    {
+        table = DynamicArray<int>(newCapacity);
+        for (size_t i = 0; i < newCapacity; i++) {
+            table[i] = -1;
+        }
+        shift = 64;
+        for (size_t c = newCapacity; c > 1; c >>= 1) {
+            --shift;
+        }
+        for (size_t slot = 0; slot < names.get_size(); slot++) {
+            size_t pos = Home(names[slot]);
+            while (table[pos] != -1) {
+                pos = (pos + 1) & Mask();
+            }
+            table[pos] = static_cast<int>(slot);
+        }
+    }
+
+public:
+    VertexIndex() : names(), table()
+    {
+        Rehash(16);
+    }
+
+    int GetSize() const
+    {
+        return static_cast<int>(names.get_size());
+    }
+
+    const T &GetName(int slot) const
+    {
+        return names[slot];
+    }
+
+    int Find(const T &name) const
+    {
+        for (size_t pos = Home(name);; pos = (pos + 1) & Mask()) {
+            int slot = table[pos];
+            if (slot == -1) {
+                return -1;
+            }
+            if (names[slot] == name) {
+                return slot;
+            }
+        }
+    }
+
+    // The caller guarantees the name is not present yet; the new slot is always the last one.
+    int Insert(const T &name)
+    {
+        if (2 * (names.get_size() + 1) > table.get_size()) {
+            names.push_back(name);
+            Rehash(table.get_size() * 2);
+            return GetSize() - 1;
+        }
+        int slot = GetSize();
+        names.push_back(name);
+        size_t pos = Home(name);
+        while (table[pos] != -1) {
+            pos = (pos + 1) & Mask();
+        }
+        table[pos] = slot;
+        return slot;
+    }
+
+    // Removes the name and shifts every following slot down by one, mirroring DynamicArray::erase.
+    void Erase(const T &name)
+    {
+        size_t pos = Home(name);
+        while (table[pos] != -1 && names[table[pos]] != name) {
+            pos = (pos + 1) & Mask();
+        }
+        int removed = table[pos];
+        if (removed == -1) {
+            return;
+        }
+
+        // Backward-shift deletion keeps probe chains intact without tombstones.
+        size_t hole = pos;
+        for (size_t next = (hole + 1) & Mask(); table[next] != -1; next = (next + 1) & Mask()) {
+            size_t home = Home(names[table[next]]);
+            if (((next - home) & Mask()) >= ((next - hole) & Mask())) {
+                table[hole] = table[next];
+                hole = next;
+            }
+        }
+        table[hole] = -1;
+
+        names.erase(names.begin() + removed);
+        for (size_t i = 0; i < table.get_size(); i++) {
+            if (table[i] > removed) {
+                --table[i];
+            }
+        }
+    }
+};
+
+#endif // VERTEXINDEX_H
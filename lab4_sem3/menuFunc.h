@@ -16,7 +16,7 @@ void displayGraph(Graph<int>& graph) {
                 std::cout << "No outgoing edges." << std::endl;
             } else {
                 for (const auto& edge : edges) {
-                    std::cout << edge.GetLast() << " (weight: " << edge.GetWeight() << "), ";
+                    std::cout << graph.GetVertexName(edge.GetTarget()) << " (weight: " << edge.GetWeight() << "), ";
                 }
                 std::cout << std::endl;
             }
@@ -40,6 +40,7 @@ void runMenu() {
         std::cout << "6. Dijkstra's algorithm\n";
         std::cout << "7. Generate random graph\n";
         std::cout << "8. Exit\n";
+        std::cout << "9. Contraction hierarchy report\n";
         std::cout << "Choose an option: ";
         std::cin >> choice;
 
@@ -119,6 +120,11 @@ void runMenu() {
             case 8: // Exit
                 std::cout << "Exiting." << std::endl;
                 break;
+            case 9: {
+                ContractionHierarchy<int> hierarchy = graph.BuildContractionHierarchy();
+                ReportContractionHierarchy(graph, hierarchy, 1000);
+                break;
+            }
             default:
                 std::cout << "Invalid choice." << std::endl;
                 break;